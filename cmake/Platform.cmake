@@ -161,6 +161,21 @@ endif()
 
 check_cxx_symbol_exists(stpcpy cstring USE_SYSTEM_STPCPY)
 
+check_cxx_symbol_exists(mmap sys/mman.h USE_POSIX_MMAP)
+
+# Older versions of glibc require linking with librt to use `shm_open()`
+set(HAS_LIBRT OFF)
+check_cxx_symbol_exists(shm_open sys/mman.h USE_POSIX_SHM)
+if(NOT USE_POSIX_SHM AND NOT MSVC)
+  set(CMAKE_REQUIRED_LIBRARIES rt)
+  check_cxx_symbol_exists(shm_open sys/mman.h USE_POSIX_SHM_LIBRT)
+  unset(CMAKE_REQUIRED_LIBRARIES)
+  if(USE_POSIX_SHM_LIBRT)
+    set(USE_POSIX_SHM ON)
+    set(HAS_LIBRT ON)
+  endif()
+endif()
+
 if(USE_LTO)
   include(CheckIPOSupported)
   check_ipo_supported(RESULT LTO_SUPPORTED OUTPUT LTO_SUPPORT_OUTPUT)
@@ -215,6 +230,12 @@ else()
   set(LIBATOMIC_TARGET)
 endif()
 
+if(HAS_LIBRT)
+  set(LIBRT_TARGET rt)
+else()
+  set(LIBRT_TARGET)
+endif()
+
 if(MSVC AND USE_SANITIZERS)
   message(WARNING "USE_SANITIZERS is not supported with MSVC; disabling it.")
   set(USE_SANITIZERS OFF)
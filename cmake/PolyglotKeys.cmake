@@ -0,0 +1,53 @@
+# This file is part of SoFCheck
+#
+# Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+#
+# SoFCheck is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# SoFCheck is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+include_guard(GLOBAL)
+
+set(POLYGLOT_RANDOM64_FILE "" CACHE FILEPATH
+  "File with the Random64 table from the Polyglot book format specification (781 hexadecimal \
+numbers). If not specified, the generated keys are used, and the opening books from other software \
+are not readable")
+
+unset(USE_POLYGLOT_RANDOM64)
+if(NOT "${POLYGLOT_RANDOM64_FILE}" STREQUAL "")
+  if(NOT EXISTS "${POLYGLOT_RANDOM64_FILE}")
+    message(FATAL_ERROR "Polyglot Random64 file \"${POLYGLOT_RANDOM64_FILE}\" does not exist")
+  endif()
+  set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS "${POLYGLOT_RANDOM64_FILE}")
+
+  file(READ "${POLYGLOT_RANDOM64_FILE}" _random64_contents)
+  string(REGEX MATCHALL "0[xX][0-9A-Fa-f]+" _random64_values "${_random64_contents}")
+  list(LENGTH _random64_values _random64_count)
+  if(NOT _random64_count EQUAL 781)
+    message(FATAL_ERROR
+      "Polyglot Random64 file must contain 781 numbers, but ${_random64_count} found")
+  endif()
+  foreach(_value IN LISTS _random64_values)
+    string(LENGTH "${_value}" _value_length)
+    if(_value_length GREATER 18)
+      message(FATAL_ERROR "Number \"${_value}\" in Polyglot Random64 file is too large")
+    endif()
+  endforeach()
+
+  list(TRANSFORM _random64_values APPEND "ULL")
+  string(REPLACE ";" ",\n    " POLYGLOT_RANDOM64_VALUES "${_random64_values}")
+  configure_file(src/core/private/polyglot_random64.h.in
+    "${PROJECT_BINARY_DIR}/src/core/private/polyglot_random64.h"
+    @ONLY
+  )
+  set(USE_POLYGLOT_RANDOM64 ON)
+endif()
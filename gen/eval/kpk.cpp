@@ -0,0 +1,215 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "core/bitboard.h"  // This header must not be higher than the others, but `clang-format`
+                            // puts it here by mistake
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "common.h"
+#include "core/types.h"
+#include "eval/private/kpk_index.h"
+#include "util/bit.h"
+#include "util/math.h"
+
+using SoFCore::bitboard_t;
+using SoFCore::Color;
+using SoFCore::coord_t;
+using SoFCore::coordToBitboard;
+using SoFEval::Private::kpkIndex;
+using SoFEval::Private::KPK_PAWN_POSITIONS;
+using SoFEval::Private::KPK_SIZE;
+
+enum class KpkState : uint8_t { Unknown, Invalid, Draw, Win };
+
+struct KpkPosition {
+  Color side;
+  coord_t whiteKing;
+  coord_t blackKing;
+  coord_t pawn;
+
+  static KpkPosition fromIndex(const size_t idx) {
+    const size_t pawnIdx = (idx / (64 * 64)) % KPK_PAWN_POSITIONS;
+    return KpkPosition{
+        (idx < KPK_SIZE / 2) ? Color::White : Color::Black,
+        static_cast<coord_t>((idx / 64) % 64),
+        static_cast<coord_t>(idx % 64),
+        SoFCore::makeCoord(static_cast<SoFCore::subcoord_t>(pawnIdx / 4 + 1),
+                           static_cast<SoFCore::subcoord_t>(pawnIdx % 4)),
+    };
+  }
+};
+
+class KpkSolver {
+public:
+  KpkSolver() : kingAttacks_(64), states_(KPK_SIZE, KpkState::Unknown) {
+    for (coord_t i = 0; i < 64; ++i) {
+      for (coord_t j = 0; j < 64; ++j) {
+        if (i != j && distance(i, j) <= 1) {
+          kingAttacks_[i] |= coordToBitboard(j);
+        }
+      }
+    }
+  }
+
+  // Solves the endgame using retrograde analysis. The positions which are not known to be won
+  // after the analysis converges are drawn
+  std::vector<KpkState> solve() {
+    for (size_t i = 0; i < KPK_SIZE; ++i) {
+      states_[i] = initialState(KpkPosition::fromIndex(i));
+    }
+    for (bool changed = true; changed;) {
+      changed = false;
+      for (size_t i = 0; i < KPK_SIZE; ++i) {
+        if (states_[i] != KpkState::Unknown) {
+          continue;
+        }
+        const KpkPosition pos = KpkPosition::fromIndex(i);
+        states_[i] = (pos.side == Color::White) ? classifyWhite(pos) : classifyBlack(pos);
+        changed |= states_[i] != KpkState::Unknown;
+      }
+    }
+    for (KpkState &state : states_) {
+      if (state == KpkState::Unknown) {
+        state = KpkState::Draw;
+      }
+    }
+    return states_;
+  }
+
+private:
+  static int distance(const coord_t a, const coord_t b) {
+    return std::max(SoFUtil::absDiff(SoFCore::coordX(a), SoFCore::coordX(b)),
+                    SoFUtil::absDiff(SoFCore::coordY(a), SoFCore::coordY(b)));
+  }
+
+  static bitboard_t pawnAttacks(const coord_t pawn) {
+    const bitboard_t bb = coordToBitboard(pawn);
+    return SoFCore::advancePawnLeft(Color::White, bb) | SoFCore::advancePawnRight(Color::White, bb);
+  }
+
+  KpkState initialState(const KpkPosition &pos) const {
+    const auto [side, whiteKing, blackKing, pawn] = pos;
+    if (distance(whiteKing, blackKing) <= 1 || whiteKing == pawn || blackKing == pawn) {
+      return KpkState::Invalid;
+    }
+    const bool isCheck = pawnAttacks(pawn) & coordToBitboard(blackKing);
+    if (side == Color::White) {
+      if (isCheck) {
+        return KpkState::Invalid;
+      }
+      // The pawn promotes and the new queen cannot be captured
+      const coord_t promote = pawn - 8;
+      if (SoFCore::coordX(pawn) == 1 && promote != whiteKing && promote != blackKing &&
+          (distance(blackKing, promote) > 1 || distance(whiteKing, promote) == 1)) {
+        return KpkState::Win;
+      }
+      return KpkState::Unknown;
+    }
+    const bitboard_t bbMoves =
+        kingAttacks_[blackKing] & ~(kingAttacks_[whiteKing] | pawnAttacks(pawn));
+    // Stalemate or the pawn is captured. Note that checkmate remains unknown here, and it is later
+    // classified as a win, as all the moves from it lead to win
+    if ((!bbMoves && !isCheck) || (bbMoves & coordToBitboard(pawn))) {
+      return KpkState::Draw;
+    }
+    return KpkState::Unknown;
+  }
+
+  KpkState classifyWhite(const KpkPosition &pos) const {
+    const coord_t whiteKing = pos.whiteKing;
+    const coord_t blackKing = pos.blackKing;
+    const coord_t pawn = pos.pawn;
+    bool allDraw = true;
+    const auto visit = [&](const coord_t newKing, const coord_t newPawn) {
+      const KpkState state = states_[kpkIndex(Color::Black, newKing, blackKing, newPawn)];
+      allDraw &= state == KpkState::Draw;
+      return state == KpkState::Win;
+    };
+    bitboard_t bbMoves =
+        kingAttacks_[whiteKing] & ~kingAttacks_[blackKing] & ~coordToBitboard(pawn);
+    while (bbMoves) {
+      if (visit(static_cast<coord_t>(SoFUtil::extractLowest(bbMoves)), pawn)) {
+        return KpkState::Win;
+      }
+    }
+    // Promotions are already handled in `initialState()`
+    const auto isFree = [&](const coord_t c) { return c != whiteKing && c != blackKing; };
+    if (SoFCore::coordX(pawn) != 1 && isFree(pawn - 8)) {
+      if (visit(whiteKing, pawn - 8)) {
+        return KpkState::Win;
+      }
+      if (SoFCore::coordX(pawn) == 6 && isFree(pawn - 16) && visit(whiteKing, pawn - 16)) {
+        return KpkState::Win;
+      }
+    }
+    return allDraw ? KpkState::Draw : KpkState::Unknown;
+  }
+
+  KpkState classifyBlack(const KpkPosition &pos) const {
+    const coord_t whiteKing = pos.whiteKing;
+    const coord_t blackKing = pos.blackKing;
+    const coord_t pawn = pos.pawn;
+    bool allWin = true;
+    bitboard_t bbMoves = kingAttacks_[blackKing] & ~(kingAttacks_[whiteKing] | pawnAttacks(pawn));
+    while (bbMoves) {
+      const auto newKing = static_cast<coord_t>(SoFUtil::extractLowest(bbMoves));
+      const KpkState state = states_[kpkIndex(Color::White, whiteKing, newKing, pawn)];
+      if (state == KpkState::Draw) {
+        return KpkState::Draw;
+      }
+      allWin &= state == KpkState::Win;
+    }
+    return allWin ? KpkState::Win : KpkState::Unknown;
+  }
+
+  std::vector<bitboard_t> kingAttacks_;
+  std::vector<KpkState> states_;
+};
+
+GeneratorInfo getGeneratorInfo() {
+  return GeneratorInfo{"Generate bitbase for king and pawn versus king endgame"};
+}
+
+int doGenerate(SourcePrinter &p) {
+  const std::vector<KpkState> states = KpkSolver().solve();
+  std::vector<uint64_t> bits(KPK_SIZE / 64);
+  for (size_t i = 0; i < KPK_SIZE; ++i) {
+    if (states[i] == KpkState::Win) {
+      bits[i >> 6] |= static_cast<uint64_t>(1) << (i & 63);
+    }
+  }
+
+  p.headerGuard("SOF_EVAL_PRIVATE_KPK_BITBASE_INCLUDED");
+  p.skip();
+  p.sysInclude("cstdint");
+  p.skip();
+  p.include("eval/private/kpk_index.h");
+  p.skip();
+  auto ns = p.inNamespace("SoFEval::Private");
+  p.skip();
+  p.line() << "// Bit with index `kpkIndex(...)` is set if the position is won by white";
+  p.lineStart() << "constexpr uint64_t KPK_BITBASE[KPK_SIZE / 64] = ";
+  p.arrayBody(bits.size(), [&](const size_t i) { printBitboard(p.stream(), bits[i]); });
+  p.line() << ";";
+  p.skip();
+
+  return 0;
+}
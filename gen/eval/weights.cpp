@@ -192,6 +192,14 @@ void fillWeights(SourcePrinter &p, const Features &features) {
 
       outCastling("KINGSIDE", psq.kingsideCastling);
       outCastling("QUEENSIDE", psq.queensideCastling);
+
+      const ArrayBundle &costs = b->pieceCosts();
+      p.lineStart() << "static constexpr Item " << formatName(b->name()) << "_COST["
+                    << costs.count() << "] = ";
+      p.arrayBody(costs.count(), [&](const size_t idx) {
+        p.stream() << "number(" << costs.name().offset + idx << ")";
+      });
+      p.stream() << ";\n";
       continue;
     }
 
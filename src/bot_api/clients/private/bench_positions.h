@@ -0,0 +1,58 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef SOF_BOT_API_CLIENTS_PRIVATE_BENCH_POSITIONS_INCLUDED
+#define SOF_BOT_API_CLIENTS_PRIVATE_BENCH_POSITIONS_INCLUDED
+
+namespace SoFBotApi::Clients::Private {
+
+// Positions searched by "bench" command. They cover the opening, the middlegame and the endgame,
+// and include positions with castling, en passant, promotions and checks. Changing this list
+// changes the bench signature
+constexpr const char *BENCH_POSITIONS[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+    "r1bq1rk1/pp2ppbp/2np1np1/8/3NP3/2N1BP2/PPPQ2PP/R3KB1R w KQ - 3 9",
+    "rnbqkb1r/pp3ppp/4pn2/2pp4/2PP4/2N1PN2/PP3PPP/R1BQKB1R w KQkq - 0 5",
+    "r2q1rk1/pp2bppp/2n1pn2/3p4/3P4/2PB1N2/PP1N1PPP/R2Q1RK1 b - - 4 11",
+    "4rrk1/2p1b1p1/p1p3q1/4p3/2P2n1p/1P1NR2P/PB3PP1/3R1QK1 b - - 2 24",
+    "r3qbrk/6p1/2b2pPp/p3pP1Q/PpPpP2P/3P1B2/2PB3K/R5R1 w - - 16 42",
+    "6k1/1R3p2/6p1/2Bp3p/3P2q1/P7/1P2rQ1K/5R2 b - - 4 44",
+    "7r/2p3k1/1p1p1qp1/1P1Bp3/p1P2r1P/P7/4R3/Q4RK1 w - - 0 36",
+    "8/8/1p2k1p1/3p3p/1p1P1P1P/1P2PK2/8/8 w - - 3 54",
+    "8/3p3B/5p2/5P2/p7/PP5b/k7/6K1 w - - 0 1",
+    "2K5/p7/7P/5pR1/8/5k2/r7/8 w - - 0 1",
+};
+
+// Positions searched by "bench stress" command. They are not reachable in a real game, but are
+// accepted by the engine and contain many pieces attacking each other, so the quiescense search
+// tree may explode in them. The benchmark checks that such positions don't hang the engine
+constexpr const char *STRESS_POSITIONS[] = {
+    "rrrrrrrr/rrrrrrrk/8/8/8/8/RRRRRRRK/RRRRRRRR w - - 0 1",
+    "qqqqqqqk/qqqqqqqq/8/8/8/8/QQQQQQQQ/KQQQQQQQ w - - 0 1",
+    "bbbbbbbk/bbbbbbbb/8/8/8/8/BBBBBBBB/KBBBBBBB w - - 0 1",
+    "k7/8/1rRrRrRr/rRrRrRrR/RrRrRrRr/1RrRrRr1/8/K7 w - - 0 1",
+    "8/PPPPPPPk/8/8/8/8/pppppppK/8 w - - 0 1",
+};
+
+}  // namespace SoFBotApi::Clients::Private
+
+#endif  // SOF_BOT_API_CLIENTS_PRIVATE_BENCH_POSITIONS_INCLUDED
@@ -20,11 +20,13 @@
 #include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <limits>
 #include <mutex>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -32,6 +34,7 @@
 
 #include "bot_api/api_base.h"
 #include "bot_api/client.h"
+#include "bot_api/clients/private/bench_positions.h"
 #include "bot_api/clients/private/uci_option_escape.h"
 #include "bot_api/options.h"
 #include "bot_api/strutil.h"
@@ -41,6 +44,7 @@
 #include "core/move_parser.h"
 #include "core/movegen.h"
 #include "core/strutil.h"
+#include "util/defer.h"
 #include "util/logging.h"
 #include "util/misc.h"
 #include "util/no_copy_move.h"
@@ -67,6 +71,12 @@ using std::chrono::steady_clock;
 constexpr const char *UCI_CLIENT = "UCI client";
 constexpr const char *UCI_SERVER = "UCI server";
 
+// Default depth for "bench" command
+constexpr size_t DEFAULT_BENCH_DEPTH = 10;
+
+// Default depth for "bench stress" command
+constexpr size_t DEFAULT_STRESS_BENCH_DEPTH = 5;
+
 // Helper macro to return error in case of I/O errors
 #define D_CHECK_IO(ioResult)     \
   {                              \
@@ -109,14 +119,22 @@ public:
     if (!searchStarted_) {
       return ApiResult::UnexpectedCall;
     }
-    D_CHECK_IO(out_ << "bestmove " << moveToStr(bestMove) << endl);
     searchStarted_ = false;
+    if (benchRunning_) {
+      benchBestMove_ = bestMove;
+      searchFinished_.notify_all();
+      return ApiResult::Ok;
+    }
+    D_CHECK_IO(out_ << "bestmove " << moveToStr(bestMove) << endl);
     return ApiResult::Ok;
   }
 
   ApiResult sendString(const char *str) override {
     ensureClient();
     std::lock_guard guard(mutex_);
+    if (benchRunning_) {
+      return ApiResult::Ok;
+    }
     D_CHECK_IO(out_ << "info string " << SoFUtil::sanitizeEol(str) << endl);
     return ApiResult::Ok;
   }
@@ -127,6 +145,10 @@ public:
     if (!searchStarted_) {
       return ApiResult::UnexpectedCall;
     }
+    if (benchRunning_) {
+      benchNodes_ = std::max(benchNodes_, nodes);
+      return ApiResult::Ok;
+    }
     const auto time = getSearchTime();
     const uint64_t timeMsec = duration_cast<milliseconds>(time).count();
     D_CHECK_IO(out_ << "info depth " << result.depth << " time " << timeMsec);
@@ -177,6 +199,10 @@ public:
     if (!searchStarted_) {
       return ApiResult::UnexpectedCall;
     }
+    if (benchRunning_) {
+      benchNodes_ = std::max(benchNodes_, nodes);
+      return ApiResult::Ok;
+    }
     const auto time = getSearchTime();
     const uint64_t timeMsec = duration_cast<milliseconds>(time).count();
     D_CHECK_IO(out_ << "info time " << timeMsec << " nodes " << nodes);
@@ -194,7 +220,7 @@ public:
     if (!searchStarted_) {
       return ApiResult::UnexpectedCall;
     }
-    if (debugEnabled_) {
+    if (debugEnabled_ && !benchRunning_) {
       D_CHECK_IO(out_ << "info string Hash table hits: " << std::to_string(hits) << endl);
     }
     return ApiResult::Ok;
@@ -209,6 +235,9 @@ public:
     if (hashFull > 1000) {
       return ApiResult::InvalidArgument;
     }
+    if (benchRunning_) {
+      return ApiResult::Ok;
+    }
     D_CHECK_IO(out_ << "info hashfull " << hashFull << endl);
     return ApiResult::Ok;
   }
@@ -219,6 +248,9 @@ public:
     if (!searchStarted_) {
       return ApiResult::UnexpectedCall;
     }
+    if (benchRunning_) {
+      return ApiResult::Ok;
+    }
     D_CHECK_IO(out_ << "info currmove " << moveToStr(move));
     if (moveNumber != 0) {
       D_CHECK_IO(out_ << " currmovenumber " << moveNumber);
@@ -268,7 +300,14 @@ public:
 
   // Constructs `UciServerConnector` with custom streams
   UciServerConnector(std::istream &in, std::ostream &out)
-      : searchStarted_(false), debugEnabled_(false), client_(nullptr), in_(in), out_(out) {}
+      : searchStarted_(false),
+        debugEnabled_(false),
+        benchRunning_(false),
+        benchNodes_(0),
+        benchBestMove_(Move::null()),
+        client_(nullptr),
+        in_(in),
+        out_(out) {}
 
   ~UciServerConnector() override {
     SOF_ASSERT_MSG("Client was not disconnected properly", !client_);
@@ -328,6 +367,12 @@ private:
   // Processes "setoption" subcommand
   PollResult processUciSetOption(std::istream &tokens);
 
+  // Processes "bench" command. This is an extension to UCI, which searches the embedded positions
+  // on the fixed depth and reports the total number of nodes and the search speed. With "stress"
+  // argument, the pathological positions are searched instead. The command is processed
+  // synchronously, so the input is not read until the benchmark finishes
+  PollResult processUciBench(std::istream &tokens);
+
   // Processes UCI command line given as a stream of tokens
   PollResult processUciCommand(std::istream &tokens);
 
@@ -373,6 +418,10 @@ private:
   std::recursive_mutex mutex_;
   bool searchStarted_;
   bool debugEnabled_;
+  bool benchRunning_;
+  uint64_t benchNodes_;
+  Move benchBestMove_;
+  std::condition_variable_any searchFinished_;
   steady_clock::time_point searchStartTime_;
   Client *client_;
   std::istream &in_;
@@ -717,6 +766,117 @@ PollResult UciServerConnector::processUciSetOption(std::istream &tokens) {
   panic("Unknown option type, end of function reached in processUciSetOption");
 }
 
+PollResult UciServerConnector::processUciBench(std::istream &tokens) {
+  if (searchStarted_) {
+    logError(UCI_SERVER) << "Cannot run the benchmark, as the search is already started";
+    return PollResult::NoData;
+  }
+
+  // Parse the arguments
+  std::optional<size_t> depth;
+  std::optional<int64_t> hash;
+  std::optional<int64_t> threads;
+  bool stress = false;
+  string token;
+  while (tokens >> token) {
+    if (token == "stress") {
+      stress = true;
+      continue;
+    }
+    if (token == "depth") {
+      size_t val = 0;
+      if (!tryReadInt(val, tokens, "size_t")) {
+        return PollResult::NoData;
+      }
+      depth = val;
+      continue;
+    }
+    if (token == "hash" || token == "threads") {
+      int64_t val = 0;
+      if (!tryReadInt(val, tokens, "int64")) {
+        return PollResult::NoData;
+      }
+      (token == "hash" ? hash : threads) = val;
+      continue;
+    }
+    logError(UCI_SERVER) << "Unexpected token \"" << token << "\" in \"bench\" command";
+    return PollResult::NoData;
+  }
+
+  // Apply the options for the benchmark and restore them after it finishes
+  Options &opts = client_->options();
+  vector<pair<string, int64_t>> oldIntOptions;
+  const auto setIntOption = [&](const string &name, const int64_t value) {
+    const MaybeIntOption option = opts.getInt(name);
+    if (!option) {
+      logWarn(UCI_SERVER) << "Option \"" << name << "\" is not supported by the engine";
+      return;
+    }
+    oldIntOptions.emplace_back(name, option->value);
+    checkClient(opts.setInt(name, value));
+  };
+  if (hash) {
+    setIntOption("Hash", *hash);
+  }
+  if (threads) {
+    setIntOption("Threads", *threads);
+  }
+  if (opts.type("Clear hash") == OptionType::Action) {
+    checkClient(opts.triggerAction("Clear hash"));
+  }
+  benchRunning_ = true;
+  SOF_DEFER({
+    benchRunning_ = false;
+    for (const auto &[name, value] : oldIntOptions) {
+      checkClient(opts.setInt(name, value));
+    }
+  });
+
+  // Run the search on each position
+  const char *const *positions = stress ? Private::STRESS_POSITIONS : Private::BENCH_POSITIONS;
+  const size_t positionCount =
+      stress ? std::size(Private::STRESS_POSITIONS) : std::size(Private::BENCH_POSITIONS);
+  const size_t searchDepth =
+      depth.value_or(stress ? DEFAULT_STRESS_BENCH_DEPTH : DEFAULT_BENCH_DEPTH);
+  uint64_t totalNodes = 0;
+  const auto startTime = steady_clock::now();
+  for (size_t i = 0; i < positionCount; ++i) {
+    Board board;  // NOLINT : the board will be initialized below
+    if (board.setFromFen(positions[i]) != SoFCore::FenParseResult::Ok) {
+      panic("Bad bench position \"" + string(positions[i]) + "\"");
+    }
+    if (checkClient(client_->setPosition(board, nullptr, 0)) != ApiResult::Ok) {
+      return PollResult::NoData;
+    }
+    benchNodes_ = 0;
+    const ApiResult searchStartResult = client_->searchFixedDepth(searchDepth);
+    if (searchStartResult != ApiResult::Ok) {
+      const char *strResult = apiResultToStr(searchStartResult);
+      logError(UCI_CLIENT) << "Cannot start search: " << strResult;
+      D_CHECK_POLL_IO(out_ << "info string Cannot start search: " << strResult << endl);
+      return PollResult::NoData;
+    }
+    searchStarted_ = true;
+    searchStartTime_ = steady_clock::now();
+    // `mutex_` is locked exactly once here (in `processUciCommand()`), so waiting on it releases
+    // it and allows the client to report the search results
+    searchFinished_.wait(mutex_, [&]() { return !searchStarted_; });
+    totalNodes += benchNodes_;
+    D_CHECK_POLL_IO(out_ << "info string Position " << (i + 1) << "/" << positionCount
+                         << ": nodes " << benchNodes_ << ", best move "
+                         << moveToStr(benchBestMove_) << endl);
+  }
+
+  const auto time = steady_clock::now() - startTime;
+  uint64_t nps = 0;
+  calcNodesPerSecond(totalNodes, time, nps);
+  D_CHECK_POLL_IO(out_ << "info string Total nodes: " << totalNodes << endl);
+  D_CHECK_POLL_IO(out_ << "info string Total time: " << duration_cast<milliseconds>(time).count()
+                       << " ms" << endl);
+  D_CHECK_POLL_IO(out_ << "info string Nodes per second: " << nps << endl);
+  return PollResult::Ok;
+}
+
 PollResult UciServerConnector::processUciCommand(std::istream &tokens) {
   std::lock_guard guard(mutex_);
 
@@ -790,6 +950,9 @@ PollResult UciServerConnector::processUciCommand(std::istream &tokens) {
       // Not supported.
       return PollResult::NoData;
     }
+    if (command == "bench") {
+      return processUciBench(tokens);
+    }
     if (command == "quit") {
       logInfo(UCI_SERVER) << "Stopping.";
       return PollResult::Shutdown;
@@ -35,6 +35,11 @@ namespace SoFBotApi::Clients {
 // are allowed.
 // - the UCI docs assume that the options are case-insensitive. This implementation assumes that
 // they are case-sensitive.
+//
+// Apart from the standard UCI commands, the implementation supports "bench [stress] [depth D]
+// [hash H] [threads T]" command. It searches the fixed set of positions (or the pathological ones
+// if "stress" is specified) and reports the total number of nodes and the search speed via "info
+// string".
 std::unique_ptr<ServerConnector> makeUciServerConnector();
 std::unique_ptr<ServerConnector> makeUciServerConnector(std::istream &in, std::ostream &out);
 
@@ -0,0 +1,151 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "core/epd.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+#include "core/strutil.h"
+#include "util/strutil.h"
+
+namespace SoFCore {
+
+using SoFUtil::isSpace;
+
+// Splits EPD record into tokens. The tokens are separated by spaces, the quoted strings form a
+// single token without the quotes, and each semicolon is a separate token
+class EpdTokenizer {
+public:
+  explicit EpdTokenizer(const std::string_view line) : line_(line) {}
+
+  // Reads the next token into `token`. Returns `false` if there are no tokens left. `quoted` is set
+  // to `true` if the token was a quoted string, so it is not interpreted as a semicolon
+  bool next(std::string &token, bool &quoted) {
+    while (pos_ < line_.size() && isSpace(line_[pos_])) {
+      ++pos_;
+    }
+    if (pos_ == line_.size()) {
+      return false;
+    }
+    token.clear();
+    quoted = line_[pos_] == '"';
+    if (quoted) {
+      const size_t end = std::min(line_.find('"', pos_ + 1), line_.size());
+      token = line_.substr(pos_ + 1, end - pos_ - 1);
+      pos_ = std::min(end + 1, line_.size());
+      return true;
+    }
+    if (line_[pos_] == ';') {
+      token = ";";
+      ++pos_;
+      return true;
+    }
+    const size_t start = pos_;
+    while (pos_ < line_.size() && !isSpace(line_[pos_]) && line_[pos_] != ';') {
+      ++pos_;
+    }
+    token = line_.substr(start, pos_ - start);
+    return true;
+  }
+
+private:
+  std::string_view line_;
+  size_t pos_ = 0;
+};
+
+// Returns `true` if `str` is a non-negative integer, so it can be a move counter in FEN
+static bool isCounter(const std::string_view str) {
+  return !str.empty() && std::all_of(str.begin(), str.end(), [](const char c) {
+    return '0' <= c && c <= '9';
+  });
+}
+
+const EpdOperation *EpdRecord::find(const std::string_view opcode) const {
+  for (const EpdOperation &operation : operations) {
+    if (operation.opcode == opcode) {
+      return &operation;
+    }
+  }
+  return nullptr;
+}
+
+SoFUtil::Result<std::optional<EpdRecord>, std::string> EpdRecord::parse(
+    const std::string_view line) {
+  EpdTokenizer tokenizer(line);
+  std::vector<std::string> fields;
+  std::string token;
+  bool quoted = false;
+  while (fields.size() < 4 && tokenizer.next(token, quoted)) {
+    fields.push_back(token);
+  }
+  if (fields.empty() || fields[0][0] == '#') {
+    return SoFUtil::Ok(std::optional<EpdRecord>());
+  }
+  if (fields.size() < 4) {
+    return SoFUtil::Err("bad position \"" + std::string(line) + "\"");
+  }
+
+  EpdRecord record;
+  record.fen = fields[0] + " " + fields[1] + " " + fields[2] + " " + fields[3];
+
+  // In FEN, the first four fields are followed by the move counters instead of the operations
+  EpdTokenizer counters = tokenizer;
+  std::string moveCounter;
+  std::string moveNumber;
+  if (counters.next(moveCounter, quoted) && isCounter(moveCounter) &&
+      counters.next(moveNumber, quoted) && isCounter(moveNumber)) {
+    record.fen += " " + moveCounter + " " + moveNumber;
+    tokenizer = counters;
+  } else {
+    record.fen += " 0 1";
+  }
+
+  auto board = Board::fromFen(record.fen.c_str());
+  if (board.isErr()) {
+    return SoFUtil::Err("cannot parse position \"" + std::string(line) +
+                        "\": " + fenParseResultToStr(std::move(board).unwrapErr()));
+  }
+  record.board = std::move(board).unwrap();
+  const ValidateResult validateRes = record.board.validate();
+  if (validateRes != ValidateResult::Ok) {
+    return SoFUtil::Err("position \"" + std::string(line) +
+                        "\" is invalid: " + validateResultToStr(validateRes));
+  }
+
+  // Each operation consists of the opcode and the operands, and is terminated by a semicolon
+  EpdOperation operation;
+  while (tokenizer.next(token, quoted)) {
+    if (!quoted && token == ";") {
+      if (!operation.opcode.empty()) {
+        record.operations.push_back(std::move(operation));
+      }
+      operation = EpdOperation();
+    } else if (operation.opcode.empty()) {
+      operation.opcode = std::move(token);
+    } else {
+      operation.operands.push_back(std::move(token));
+    }
+  }
+  if (!operation.opcode.empty()) {
+    record.operations.push_back(std::move(operation));
+  }
+  return SoFUtil::Ok(std::optional<EpdRecord>(std::move(record)));
+}
+
+}  // namespace SoFCore
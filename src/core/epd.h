@@ -0,0 +1,55 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef SOF_CORE_EPD_INCLUDED
+#define SOF_CORE_EPD_INCLUDED
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/board.h"
+#include "util/result.h"
+
+namespace SoFCore {
+
+// Operation of an EPD record, e.g. `bm Nf3 e4;`. The quotes around the operands are removed
+struct EpdOperation {
+  std::string opcode;
+  std::vector<std::string> operands;
+};
+
+// Position read from a line of EPD file
+struct EpdRecord {
+  // FEN of the position. If the record doesn't contain move counters, they are set to "0 1"
+  std::string fen;
+  Board board;
+  std::vector<EpdOperation> operations;
+
+  // Returns the operation with opcode `opcode`, or `nullptr` if there is no such operation
+  const EpdOperation *find(std::string_view opcode) const;
+
+  // Parses the line of EPD file. The lines which contain FEN with move counters are also accepted,
+  // so the same function can be used to read the files with FENs. The position is checked to be
+  // valid. Returns `std::nullopt` if the line is empty or is a comment starting with "#"
+  static SoFUtil::Result<std::optional<EpdRecord>, std::string> parse(std::string_view line);
+};
+
+}  // namespace SoFCore
+
+#endif  // SOF_CORE_EPD_INCLUDED
@@ -18,6 +18,7 @@
 #include "core/init.h"
 
 #include "core/private/magic.h"
+#include "core/private/polyglot_keys.h"
 #include "core/private/zobrist.h"
 
 namespace SoFCore {
@@ -25,6 +26,7 @@ namespace SoFCore {
 void init() {
   Private::initMagic();
   Private::initZobrist();
+  Private::initPolyglotKeys();
 }
 
 }  // namespace SoFCore
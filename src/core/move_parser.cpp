@@ -18,8 +18,11 @@
 #include "core/move_parser.h"
 
 #include <algorithm>
+#include <cstddef>
+#include <optional>
 
 #include "core/board.h"
+#include "core/movegen.h"
 #include "core/private/geometry.h"
 #include "core/strutil.h"
 #include "util/misc.h"
@@ -118,4 +121,99 @@ Move moveFromParsed(const ParsedMove parsedMove, const Board &board) {
                                       : moveFromParsedImpl<Color::Black>(parsedMove, board);
 }
 
+// Returns the letter which denotes `piece` in SAN
+inline static constexpr char pieceToSanChar(const Piece piece) {
+  return "PKNBRQ"[static_cast<int8_t>(piece)];
+}
+
+Move moveParseSan(std::string_view str, const Board &board) {
+  while (!str.empty() && std::string_view("+#!?").find(str.back()) != std::string_view::npos) {
+    str.remove_suffix(1);
+  }
+  if (str.empty()) {
+    return Move::invalid();
+  }
+
+  Move moves[BUFSZ_MOVES];
+  const size_t count = MoveGen(board).genAllMoves(moves);
+  const auto isLegal = [&](const Move move) {
+    return std::find(moves, moves + count, move) != moves + count && isMoveLegal(board, move);
+  };
+
+  // Try UCI notation first
+  if (const Move move = moveParse(str.data(), str.data() + str.size(), board);
+      move.kind != MoveKind::Invalid && isLegal(move)) {
+    return move;
+  }
+
+  // Castling is written without the destination square
+  std::optional<MoveKind> castling;
+  if (str == "O-O" || str == "0-0") {
+    castling = MoveKind::CastlingKingside;
+  } else if (str == "O-O-O" || str == "0-0-0") {
+    castling = MoveKind::CastlingQueenside;
+  }
+  if (castling) {
+    for (size_t i = 0; i < count; ++i) {
+      if (moves[i].kind == *castling && isMoveLegal(board, moves[i])) {
+        return moves[i];
+      }
+    }
+    return Move::invalid();
+  }
+
+  // Split the move into the piece, the disambiguation, the destination and the promote piece
+  char piece = 'P';
+  if (std::string_view("KNBRQ").find(str.front()) != std::string_view::npos) {
+    piece = str.front();
+    str.remove_prefix(1);
+  }
+  char promote = '\0';
+  if (piece == 'P' && !str.empty() &&
+      std::string_view("NBRQ").find(str.back()) != std::string_view::npos) {
+    promote = str.back();
+    str.remove_suffix(1);
+    if (!str.empty() && str.back() == '=') {
+      str.remove_suffix(1);
+    }
+  }
+  if (str.size() < 2 || !isYCharValid(str[str.size() - 2]) || !isXCharValid(str.back())) {
+    return Move::invalid();
+  }
+  const coord_t dst = charsToCoord(str[str.size() - 2], str.back());
+  str.remove_suffix(2);
+  if (!str.empty() && str.back() == 'x') {
+    str.remove_suffix(1);
+  }
+  if (str.size() > 2) {
+    return Move::invalid();
+  }
+
+  Move result = Move::invalid();
+  for (size_t i = 0; i < count; ++i) {
+    const Move move = moves[i];
+    if (move.dst != dst || move.kind == MoveKind::CastlingKingside ||
+        move.kind == MoveKind::CastlingQueenside) {
+      continue;
+    }
+    const char movePiece = pieceToSanChar(cellPiece(board.cells[move.src]));
+    const char movePromote =
+        isMoveKindPromote(move.kind) ? pieceToSanChar(moveKindPromotePiece(move.kind)) : '\0';
+    if (movePiece != piece || movePromote != promote) {
+      continue;
+    }
+    const bool matches = std::all_of(str.begin(), str.end(), [&](const char c) {
+      return c == ySubToChar(coordY(move.src)) || c == xSubToChar(coordX(move.src));
+    });
+    if (!matches || !isMoveLegal(board, move)) {
+      continue;
+    }
+    if (result != Move::invalid()) {
+      return Move::invalid();
+    }
+    result = move;
+  }
+  return result;
+}
+
 }  // namespace SoFCore
@@ -20,6 +20,7 @@
 
 #include <cstdint>
 #include <cstring>
+#include <string_view>
 
 #include "core/move.h"
 #include "core/types.h"
@@ -90,6 +91,11 @@ inline Move moveParse(const char *str, const Board &board) {
   return moveFromParsed(parsed, board);
 }
 
+// Finds the legal move in position `board` which is written as `str` in SAN. Check and annotation
+// suffixes (like "+", "#" or "!?") are ignored. Moves in UCI notation are also accepted. Returns
+// `Move::invalid()` if there is no such move or the move is ambiguous
+Move moveParseSan(std::string_view str, const Board &board);
+
 }  // namespace SoFCore
 
 #endif  // SOF_CORE_MOVE_PARSER_INCLUDED
@@ -0,0 +1,105 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "core/polyglot.h"
+
+#include <cstddef>
+
+#include "core/movegen.h"
+#include "core/private/geometry.h"
+#include "core/private/polyglot_keys.h"
+
+namespace SoFCore {
+
+using namespace Private;
+
+// Converts the coordinate into Polyglot square number, in which A1 is zero and H8 is 63
+inline static constexpr uint16_t polyglotSquare(const coord_t coord) {
+  return static_cast<uint16_t>(((7 - coordX(coord)) << 3) | coordY(coord));
+}
+
+// Returns the index of the piece in Polyglot, in which the black pieces go first and the pieces
+// are ordered as pawn, knight, bishop, rook, queen and king
+inline static constexpr size_t polyglotPieceKind(const cell_t cell) {
+  constexpr size_t PIECE_ORDER[6] = {0, 5, 1, 2, 3, 4};
+  const size_t idx = PIECE_ORDER[static_cast<size_t>(cellPiece(cell))];
+  return 2 * idx + (cellPieceColor(cell) == Color::White ? 1 : 0);
+}
+
+board_hash_t polyglotKey(const Board &b) {
+  board_hash_t key = 0;
+  for (coord_t i = 0; i < 64; ++i) {
+    const cell_t cell = b.cells[i];
+    if (cell != EMPTY_CELL) {
+      key ^= g_polyglotKeys[POLYGLOT_PIECES_OFFSET + 64 * polyglotPieceKind(cell) +
+                            polyglotSquare(i)];
+    }
+  }
+
+  const Castling castlings[4] = {Castling::WhiteKingside, Castling::WhiteQueenside,
+                                 Castling::BlackKingside, Castling::BlackQueenside};
+  for (size_t i = 0; i < 4; ++i) {
+    if ((b.castling & castlings[i]) != Castling::None) {
+      key ^= g_polyglotKeys[POLYGLOT_CASTLING_OFFSET + i];
+    }
+  }
+
+  // En passant is taken into account only if there is a pawn which can capture
+  if (b.enpassantCoord != INVALID_COORD) {
+    const coord_t coord = b.enpassantCoord;
+    const cell_t pawn = makeCell(b.side, Piece::Pawn);
+    const subcoord_t y = coordY(coord);
+    if ((y != 0 && b.cells[coord - 1] == pawn) || (y != 7 && b.cells[coord + 1] == pawn)) {
+      key ^= g_polyglotKeys[POLYGLOT_ENPASSANT_OFFSET + y];
+    }
+  }
+
+  if (b.side == Color::White) {
+    key ^= g_polyglotKeys[POLYGLOT_TURN_OFFSET];
+  }
+  return key;
+}
+
+uint16_t polyglotMoveEncode(const Board &b, const Move move) {
+  // Castling is encoded as the king capturing its own rook
+  coord_t dst = move.dst;
+  if (move.kind == MoveKind::CastlingKingside) {
+    dst = castlingOffset(b.side) + 7;
+  } else if (move.kind == MoveKind::CastlingQueenside) {
+    dst = castlingOffset(b.side);
+  }
+  uint16_t promote = 0;
+  if (isMoveKindPromote(move.kind)) {
+    promote = static_cast<uint16_t>(static_cast<int>(moveKindPromotePiece(move.kind)) -
+                                    static_cast<int>(Piece::Knight) + 1);
+  }
+  return static_cast<uint16_t>(polyglotSquare(dst) | (polyglotSquare(move.src) << 6) |
+                               (promote << 12));
+}
+
+Move polyglotMoveDecode(const Board &b, const uint16_t move) {
+  Move moves[BUFSZ_MOVES];
+  const size_t count = MoveGen(b).genAllMoves(moves);
+  for (size_t i = 0; i < count; ++i) {
+    if (polyglotMoveEncode(b, moves[i]) == move && isMoveLegal(b, moves[i])) {
+      return moves[i];
+    }
+  }
+  return Move::invalid();
+}
+
+}  // namespace SoFCore
@@ -0,0 +1,42 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef SOF_CORE_POLYGLOT_INCLUDED
+#define SOF_CORE_POLYGLOT_INCLUDED
+
+#include <cstdint>
+
+#include "core/board.h"
+#include "core/move.h"
+#include "core/types.h"
+
+namespace SoFCore {
+
+// Returns the key of the position `b`, which is used to find it in Polyglot opening books
+board_hash_t polyglotKey(const Board &b);
+
+// Encodes `move` from the position `b` in the format of Polyglot opening books. The move must be
+// pseudo-legal
+uint16_t polyglotMoveEncode(const Board &b, Move move);
+
+// Decodes the move `move` in the format of Polyglot opening books, applied from the position `b`.
+// Returns `Move::invalid()` if there is no such legal move
+Move polyglotMoveDecode(const Board &b, uint16_t move);
+
+}  // namespace SoFCore
+
+#endif  // SOF_CORE_POLYGLOT_INCLUDED
@@ -0,0 +1,55 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "core/private/polyglot_keys.h"
+
+#include "config.h"
+
+#ifdef USE_POLYGLOT_RANDOM64
+#include <algorithm>
+#include <iterator>
+
+#include "core/private/polyglot_random64.h"
+#else
+#include <random>
+#endif
+
+namespace SoFCore::Private {
+
+board_hash_t g_polyglotKeys[POLYGLOT_KEYS_SZ];
+
+#ifdef USE_POLYGLOT_RANDOM64
+static_assert(std::size(POLYGLOT_RANDOM64) == POLYGLOT_KEYS_SZ);
+
+void initPolyglotKeys() {
+  std::copy(std::begin(POLYGLOT_RANDOM64), std::end(POLYGLOT_RANDOM64), g_polyglotKeys);
+}
+#else
+// Seed for the opening book keys, used if the build is configured without the Random64 table from
+// Polyglot (see `POLYGLOT_RANDOM64_FILE` in CMake). In this case, only the books built with the
+// same keys (e.g. by `make_book`) can be read
+constexpr uint64_t POLYGLOT_SEED = 0x2c6f'98e4'1db7'03a5;
+
+void initPolyglotKeys() {
+  std::mt19937_64 random(POLYGLOT_SEED);
+  for (board_hash_t &key : g_polyglotKeys) {
+    key = random();
+  }
+}
+#endif
+
+}  // namespace SoFCore::Private
@@ -0,0 +1,42 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef SOF_CORE_PRIVATE_POLYGLOT_KEYS_INCLUDED
+#define SOF_CORE_PRIVATE_POLYGLOT_KEYS_INCLUDED
+
+#include <cstddef>
+
+#include "core/types.h"
+
+namespace SoFCore::Private {
+
+// Layout of the keys in Polyglot opening books: 768 keys for pieces (indexed by `64 * kind +
+// square`, see `polyglotKey()` for details), then 4 keys for castling, 8 keys for en passant files
+// and one key for the move side
+constexpr size_t POLYGLOT_PIECES_OFFSET = 0;
+constexpr size_t POLYGLOT_CASTLING_OFFSET = 768;
+constexpr size_t POLYGLOT_ENPASSANT_OFFSET = 772;
+constexpr size_t POLYGLOT_TURN_OFFSET = 780;
+constexpr size_t POLYGLOT_KEYS_SZ = 781;
+
+extern board_hash_t g_polyglotKeys[POLYGLOT_KEYS_SZ];
+
+void initPolyglotKeys();
+
+}  // namespace SoFCore::Private
+
+#endif  // SOF_CORE_PRIVATE_POLYGLOT_KEYS_INCLUDED
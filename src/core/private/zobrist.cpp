@@ -19,10 +19,10 @@
 
 #include <cstddef>
 #include <initializer_list>
+#include <random>
 
 #include "core/private/geometry.h"
 #include "core/types.h"
-#include "util/random.h"
 
 namespace SoFCore::Private {
 
@@ -33,21 +33,25 @@ board_hash_t g_zobristEnpassant[64];
 board_hash_t g_zobristPieceCastlingKingside[2];
 board_hash_t g_zobristPieceCastlingQueenside[2];
 
+// Seed for Zobrist keys. The keys are the same in all runs, so the search results are reproducible
+constexpr uint64_t ZOBRIST_SEED = 0x50fc'4ec7'a5b1'6e9d;
+
 void initZobrist() {
+  std::mt19937_64 random(ZOBRIST_SEED);
   for (size_t j = 0; j < 64; ++j) {
     g_zobristPieces[0][j] = 0;
   }
   for (size_t i = 1; i < 16; ++i) {
     for (size_t j = 0; j < 64; ++j) {
-      g_zobristPieces[i][j] = SoFUtil::random();
+      g_zobristPieces[i][j] = random();
     }
   }
-  g_zobristMoveSide = SoFUtil::random();
+  g_zobristMoveSide = random();
   for (board_hash_t &hash : g_zobristCastling) {
-    hash = SoFUtil::random();
+    hash = random();
   }
   for (board_hash_t &hash : g_zobristEnpassant) {
-    hash = SoFUtil::random();
+    hash = random();
   }
   for (Color c : {Color::White, Color::Black}) {
     const auto idx = static_cast<size_t>(c);
@@ -0,0 +1,30 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include "core/init.h"
+
+// Most of the functions in `SoFCore` require the core to be initialized, so we do it before
+// running any of the tests
+class CoreEnvironment : public testing::Environment {
+public:
+  void SetUp() override { SoFCore::init(); }
+};
+
+static testing::Environment *const CORE_ENVIRONMENT =
+    testing::AddGlobalTestEnvironment(new CoreEnvironment);
@@ -0,0 +1,70 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "core/epd.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "core/board.h"
+
+using SoFCore::Board;
+using SoFCore::EpdOperation;
+using SoFCore::EpdRecord;
+
+TEST(SoFCore, EpdRecord_Parse) {
+  auto result = EpdRecord::parse(
+      "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - bm e4 d4; id \"start; pos\";");
+  ASSERT_TRUE(result.isOk());
+  const auto record = std::move(result).unwrap();
+  ASSERT_TRUE(record);
+  EXPECT_EQ(record->fen, "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+  EXPECT_EQ(record->board, Board::initialPosition());
+  ASSERT_EQ(record->operations.size(), 2);
+
+  const EpdOperation *bm = record->find("bm");
+  ASSERT_NE(bm, nullptr);
+  EXPECT_EQ(bm->operands, (std::vector<std::string>{"e4", "d4"}));
+  const EpdOperation *id = record->find("id");
+  ASSERT_NE(id, nullptr);
+  EXPECT_EQ(id->operands, std::vector<std::string>{"start; pos"});
+  EXPECT_EQ(record->find("am"), nullptr);
+}
+
+TEST(SoFCore, EpdRecord_ParseFen) {
+  const char *fen = "4k3/8/8/8/8/8/8/4K3 b - - 12 40";
+  const auto record = EpdRecord::parse(fen).unwrap();
+  ASSERT_TRUE(record);
+  EXPECT_EQ(record->fen, fen);
+  EXPECT_EQ(record->board.moveCounter, 12);
+  EXPECT_EQ(record->board.moveNumber, 40);
+  EXPECT_TRUE(record->operations.empty());
+}
+
+TEST(SoFCore, EpdRecord_Skip) {
+  EXPECT_FALSE(EpdRecord::parse("").unwrap());
+  EXPECT_FALSE(EpdRecord::parse("   ").unwrap());
+  EXPECT_FALSE(EpdRecord::parse("# 4k3/8/8/8/8/8/8/4K3 w - - bm Kd2;").unwrap());
+}
+
+TEST(SoFCore, EpdRecord_Errors) {
+  EXPECT_TRUE(EpdRecord::parse("4k3/8/8/8/8/8/8/4K3 w").isErr());
+  EXPECT_TRUE(EpdRecord::parse("4k3/8/8/8/8/8/4K3 w - - bm Kd2;").isErr());
+  EXPECT_TRUE(EpdRecord::parse("8/8/8/8/8/8/8/4K3 w - - bm Kd2;").isErr());
+}
@@ -0,0 +1,115 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "core/move_parser.h"
+
+#include <gtest/gtest.h>
+
+#include "core/board.h"
+#include "core/move.h"
+
+using SoFCore::Board;
+using SoFCore::Move;
+using SoFCore::MoveKind;
+using SoFCore::moveParse;
+using SoFCore::moveParseSan;
+
+static Board boardFromFen(const char *fen) { return Board::fromFen(fen).unwrap(); }
+
+TEST(SoFCore, MoveParseSan_Simple) {
+  const Board board = Board::initialPosition();
+  EXPECT_EQ(moveParseSan("Nf3", board), moveParse("g1f3", board));
+  EXPECT_EQ(moveParseSan("e4", board), moveParse("e2e4", board));
+  EXPECT_EQ(moveParseSan("e3", board), moveParse("e2e3", board));
+  EXPECT_EQ(moveParseSan("Nf3!?", board), moveParse("g1f3", board));
+
+  // UCI notation is also accepted
+  EXPECT_EQ(moveParseSan("b1c3", board), moveParse("b1c3", board));
+
+  // Illegal and malformed moves
+  EXPECT_EQ(moveParseSan("Nd2", board), Move::invalid());
+  EXPECT_EQ(moveParseSan("Ke2", board), Move::invalid());
+  EXPECT_EQ(moveParseSan("e5", board), Move::invalid());
+  EXPECT_EQ(moveParseSan("e2e5", board), Move::invalid());
+  EXPECT_EQ(moveParseSan("Zf3", board), Move::invalid());
+  EXPECT_EQ(moveParseSan("", board), Move::invalid());
+  EXPECT_EQ(moveParseSan("+", board), Move::invalid());
+}
+
+TEST(SoFCore, MoveParseSan_Disambiguation) {
+  const Board knights = boardFromFen("4k3/8/8/8/8/5N2/8/1N2K3 w - - 0 1");
+  EXPECT_EQ(moveParseSan("Nd2", knights), Move::invalid());
+  EXPECT_EQ(moveParseSan("Nbd2", knights), moveParse("b1d2", knights));
+  EXPECT_EQ(moveParseSan("Nfd2", knights), moveParse("f3d2", knights));
+  EXPECT_EQ(moveParseSan("Nf3d2", knights), moveParse("f3d2", knights));
+  EXPECT_EQ(moveParseSan("Nd4", knights), moveParse("f3d4", knights));
+  EXPECT_EQ(moveParseSan("Nbd4", knights), Move::invalid());
+
+  const Board rooks = boardFromFen("4k3/8/8/R7/8/8/8/R3K3 w - - 0 1");
+  EXPECT_EQ(moveParseSan("Ra3", rooks), Move::invalid());
+  EXPECT_EQ(moveParseSan("R1a3", rooks), moveParse("a1a3", rooks));
+  EXPECT_EQ(moveParseSan("R5a3", rooks), moveParse("a5a3", rooks));
+  EXPECT_EQ(moveParseSan("Ra1a3", rooks), moveParse("a1a3", rooks));
+  EXPECT_EQ(moveParseSan("Rb1", rooks), moveParse("a1b1", rooks));
+}
+
+TEST(SoFCore, MoveParseSan_Captures) {
+  const Board board = boardFromFen("4k3/8/8/2Pp4/4P3/8/8/4K3 w - d6 0 1");
+  EXPECT_EQ(moveParseSan("exd5", board), moveParse("e4d5", board));
+  EXPECT_EQ(moveParseSan("ed5", board), moveParse("e4d5", board));
+  EXPECT_EQ(moveParseSan("cxd6", board), moveParse("c5d6", board));
+  EXPECT_EQ(moveParseSan("cxd6", board).kind, MoveKind::Enpassant);
+  EXPECT_EQ(moveParseSan("xd5", board), moveParse("e4d5", board));
+}
+
+TEST(SoFCore, MoveParseSan_Promotion) {
+  const Board board = boardFromFen("r3k3/1P6/8/8/8/8/8/4K3 w - - 0 1");
+  EXPECT_EQ(moveParseSan("b8=Q", board), moveParse("b7b8q", board));
+  EXPECT_EQ(moveParseSan("b8=Q", board).kind, MoveKind::PromoteQueen);
+  EXPECT_EQ(moveParseSan("b8N", board), moveParse("b7b8n", board));
+  EXPECT_EQ(moveParseSan("bxa8=R", board), moveParse("b7a8r", board));
+  EXPECT_EQ(moveParseSan("bxa8=B", board).kind, MoveKind::PromoteBishop);
+  EXPECT_EQ(moveParseSan("b8", board), Move::invalid());
+  EXPECT_EQ(moveParseSan("b8=K", board), Move::invalid());
+}
+
+TEST(SoFCore, MoveParseSan_Castling) {
+  const Board white = boardFromFen("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1");
+  EXPECT_EQ(moveParseSan("O-O", white), moveParse("e1g1", white));
+  EXPECT_EQ(moveParseSan("O-O", white).kind, MoveKind::CastlingKingside);
+  EXPECT_EQ(moveParseSan("0-0-0", white), moveParse("e1c1", white));
+  EXPECT_EQ(moveParseSan("O-O-O", white).kind, MoveKind::CastlingQueenside);
+
+  const Board black = boardFromFen("r3k2r/8/8/8/8/8/8/R3K2R b Kq - 0 1");
+  EXPECT_EQ(moveParseSan("O-O-O", black), moveParse("e8c8", black));
+  EXPECT_EQ(moveParseSan("O-O", black), Move::invalid());
+
+  // Castling through the attacked square is illegal
+  const Board attacked = boardFromFen("r3k2r/8/8/8/8/8/6r1/R3K2R w KQkq - 0 1");
+  EXPECT_EQ(moveParseSan("O-O", attacked), Move::invalid());
+  EXPECT_EQ(moveParseSan("O-O-O", attacked), moveParse("e1c1", attacked));
+}
+
+TEST(SoFCore, MoveParseSan_CheckSuffix) {
+  const Board board =
+      boardFromFen("rnbqkbnr/pppp1ppp/8/4p3/6P1/5P2/PPPPP2P/RNBQKBNR b KQkq - 0 2");
+  EXPECT_EQ(moveParseSan("Qh4#", board), moveParse("d8h4", board));
+  EXPECT_EQ(moveParseSan("Qh4+", board), moveParse("d8h4", board));
+  EXPECT_EQ(moveParseSan("Qh4", board), moveParse("d8h4", board));
+  EXPECT_EQ(moveParseSan("Qxh4#", board), moveParse("d8h4", board));
+  EXPECT_EQ(moveParseSan("Bc5+!", board), moveParse("f8c5", board));
+}
@@ -0,0 +1,207 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "core/polyglot.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <sstream>
+#include <string>
+
+#include "config.h"
+#include "core/board.h"
+#include "core/move.h"
+#include "core/move_parser.h"
+#include "core/private/polyglot_keys.h"
+
+using SoFCore::Board;
+using SoFCore::board_hash_t;
+using SoFCore::Move;
+using SoFCore::moveParse;
+using SoFCore::polyglotKey;
+using SoFCore::polyglotMoveDecode;
+using SoFCore::polyglotMoveEncode;
+using SoFCore::Private::g_polyglotKeys;
+
+// Computes the key of the position given in FEN directly as described in the Polyglot book format
+// specification, without using `Board`
+static board_hash_t specKey(const std::string &fen) {
+  std::istringstream stream(fen);
+  std::string placement;
+  std::string side;
+  std::string castling;
+  std::string enpassant;
+  stream >> placement >> side >> castling >> enpassant;
+
+  constexpr const char *KINDS = "pPnNbBrRqQkK";
+  char cells[8][8] = {};  // Indexed by row (zero for rank 1) and file
+  board_hash_t key = 0;
+  int row = 7;
+  int file = 0;
+  for (const char c : placement) {
+    if (c == '/') {
+      --row;
+      file = 0;
+    } else if (c >= '1' && c <= '8') {
+      file += c - '0';
+    } else {
+      const auto kind = static_cast<size_t>(std::strchr(KINDS, c) - KINDS);
+      key ^= g_polyglotKeys[64 * kind + 8 * row + file];
+      cells[row][file] = c;
+      ++file;
+    }
+  }
+
+  const std::string castlingChars = "KQkq";
+  for (size_t i = 0; i < 4; ++i) {
+    if (castling.find(castlingChars[i]) != std::string::npos) {
+      key ^= g_polyglotKeys[768 + i];
+    }
+  }
+
+  // En passant file is hashed only if there is a pawn of the side to move next to the pawn which
+  // has just made a double move
+  if (enpassant != "-") {
+    const int epFile = enpassant[0] - 'a';
+    const int pawnRow = side == "w" ? 4 : 3;
+    const char pawn = side == "w" ? 'P' : 'p';
+    if ((epFile != 0 && cells[pawnRow][epFile - 1] == pawn) ||
+        (epFile != 7 && cells[pawnRow][epFile + 1] == pawn)) {
+      key ^= g_polyglotKeys[772 + epFile];
+    }
+  }
+
+  if (side == "w") {
+    key ^= g_polyglotKeys[780];
+  }
+  return key;
+}
+
+// Applies the moves in UCI notation to the initial position
+static Board makeBoard(std::initializer_list<const char *> moves) {
+  Board board = Board::initialPosition();
+  for (const char *str : moves) {
+    const Move move = moveParse(str, board);
+    EXPECT_TRUE(move.isWellFormed(board.side)) << str;
+    moveMake(board, move);
+  }
+  return board;
+}
+
+// Reference positions from the Polyglot book format specification with their keys
+struct ReferencePosition {
+  std::initializer_list<const char *> moves;
+  const char *fen;
+  board_hash_t key;
+};
+
+static const ReferencePosition REFERENCE_POSITIONS[] = {
+    {{}, "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 0x463b96181691fc9c},
+    {{"e2e4"}, "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1", 0x823c9b50fd114196},
+    {{"e2e4", "d7d5"}, "rnbqkbnr/ppp1pppp/8/3p4/4P3/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 2",
+     0x0756b94461c50fb0},
+    {{"e2e4", "d7d5", "e4e5"}, "rnbqkbnr/ppp1pppp/8/3pP3/8/8/PPPP1PPP/RNBQKBNR b KQkq - 0 2",
+     0x662fafb965db29d4},
+    {{"e2e4", "d7d5", "e4e5", "f7f5"},
+     "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3", 0x22a48b5a8e47ff78},
+    {{"e2e4", "d7d5", "e4e5", "f7f5", "e1e2"},
+     "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR b kq - 0 3", 0x652a607ca3f242c1},
+    {{"e2e4", "d7d5", "e4e5", "f7f5", "e1e2", "e8f7"},
+     "rnbq1bnr/ppp1pkpp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR w - - 0 4", 0x00fdd303c946bdd9},
+    {{"a2a4", "b7b5", "h2h4", "b5b4", "c2c4"},
+     "rnbqkbnr/p1pppppp/8/8/PpP4P/8/1P1PPPP1/RNBQKBNR b KQkq c3 0 3", 0x3c8123ea7b067637},
+    {{"a2a4", "b7b5", "h2h4", "b5b4", "c2c4", "b4c3", "a1a3"},
+     "rnbqkbnr/p1pppppp/8/8/P6P/R1p5/1P1PPPP1/1NBQKBNR b Kkq - 0 4", 0x5c3f9b829b279560},
+};
+
+TEST(SoFCore, PolyglotKey_Layout) {
+  for (const ReferencePosition &position : REFERENCE_POSITIONS) {
+    const board_hash_t expected = specKey(position.fen);
+    EXPECT_EQ(polyglotKey(makeBoard(position.moves)), expected) << position.fen;
+    EXPECT_EQ(polyglotKey(Board::fromFen(position.fen).unwrap()), expected) << position.fen;
+  }
+}
+
+TEST(SoFCore, PolyglotKey_Reference) {
+#ifdef USE_POLYGLOT_RANDOM64
+  for (const ReferencePosition &position : REFERENCE_POSITIONS) {
+    EXPECT_EQ(polyglotKey(makeBoard(position.moves)), position.key) << position.fen;
+    EXPECT_EQ(polyglotKey(Board::fromFen(position.fen).unwrap()), position.key) << position.fen;
+  }
+#else
+  GTEST_SKIP() << "The build is configured without POLYGLOT_RANDOM64_FILE";
+#endif
+}
+
+TEST(SoFCore, PolyglotKey_Distinct) {
+  const Board initial = Board::initialPosition();
+  const Board afterE4 = makeBoard({"e2e4"});
+  EXPECT_NE(polyglotKey(initial), polyglotKey(afterE4));
+
+  // Transpositions must give the same key
+  EXPECT_EQ(polyglotKey(makeBoard({"g1f3", "g8f6", "b1c3"})),
+            polyglotKey(makeBoard({"b1c3", "g8f6", "g1f3"})));
+
+  // Positions which differ only in the move side or castling rights must have different keys
+  const Board blackToMove =
+      Board::fromFen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR b KQkq - 0 1").unwrap();
+  const Board noCastling =
+      Board::fromFen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w Kkq - 0 1").unwrap();
+  EXPECT_NE(polyglotKey(blackToMove), polyglotKey(initial));
+  EXPECT_NE(polyglotKey(noCastling), polyglotKey(initial));
+  EXPECT_EQ(polyglotKey(makeBoard({"g1f3", "g8f6", "f3g1", "f6g8"})), polyglotKey(initial));
+}
+
+TEST(SoFCore, PolyglotMove_Encode) {
+  // The move is encoded as `to | (from << 6) | (promote << 12)`, where squares are numbered from
+  // A1 to H8
+  const Board initial = Board::initialPosition();
+  const Move e2e4 = moveParse("e2e4", initial);
+  EXPECT_EQ(polyglotMoveEncode(initial, e2e4), (12 << 6) | 28);
+  EXPECT_EQ(polyglotMoveDecode(initial, (12 << 6) | 28), e2e4);
+
+  // Castling is encoded as the king capturing its own rook
+  const Board castling =
+      Board::fromFen("r3k2r/pppppppp/8/8/8/8/PPPPPPPP/R3K2R w KQkq - 0 1").unwrap();
+  const Move kingside = moveParse("e1g1", castling);
+  const Move queenside = moveParse("e1c1", castling);
+  EXPECT_EQ(polyglotMoveEncode(castling, kingside), (4 << 6) | 7);
+  EXPECT_EQ(polyglotMoveEncode(castling, queenside), (4 << 6) | 0);
+  EXPECT_EQ(polyglotMoveDecode(castling, (4 << 6) | 7), kingside);
+  EXPECT_EQ(polyglotMoveDecode(castling, (4 << 6) | 0), queenside);
+
+  const Board blackCastling =
+      Board::fromFen("r3k2r/pppppppp/8/8/8/8/PPPPPPPP/R3K2R b KQkq - 0 1").unwrap();
+  EXPECT_EQ(polyglotMoveEncode(blackCastling, moveParse("e8g8", blackCastling)), (60 << 6) | 63);
+
+  // Promotions are numbered as knight = 1, bishop = 2, rook = 3, queen = 4
+  const Board promote = Board::fromFen("8/4P3/8/8/8/8/8/k6K w - - 0 1").unwrap();
+  const char *promotes[] = {"e7e8n", "e7e8b", "e7e8r", "e7e8q"};
+  for (int i = 0; i < 4; ++i) {
+    const Move move = moveParse(promotes[i], promote);
+    const auto encoded = static_cast<uint16_t>(((i + 1) << 12) | (52 << 6) | 60);
+    EXPECT_EQ(polyglotMoveEncode(promote, move), encoded) << promotes[i];
+    EXPECT_EQ(polyglotMoveDecode(promote, encoded), move) << promotes[i];
+  }
+
+  // Illegal moves are not decoded
+  EXPECT_EQ(polyglotMoveDecode(initial, (12 << 6) | 36), Move::invalid());
+}
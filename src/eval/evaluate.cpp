@@ -19,10 +19,12 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <type_traits>
 #include <utility>
 
 #include "core/bitboard.h"
 #include "eval/coefs.h"
+#include "eval/kpk.h"
 #include "eval/private/bitboard.h"
 #include "eval/private/cache.h"
 #include "eval/private/consts.h"
@@ -328,6 +330,20 @@ private:
   const coef_t stage_;
 };
 
+// Returns the bonus for the winning side in king and pawn versus king endgame. The bonus is
+// positive if white wins and negative if black wins
+static score_t kpkWinBonus(const Board &b) {
+  const Color strong =
+      b.bbPieces[makeCell(Color::White, Piece::Pawn)] ? Color::White : Color::Black;
+  const auto pawn =
+      static_cast<coord_t>(SoFUtil::getLowest(b.bbPieces[makeCell(strong, Piece::Pawn)]));
+  const subcoord_t row = SoFCore::coordX(pawn);
+  const auto advance = static_cast<score_t>((strong == Color::White) ? 6 - row : row - 1);
+  const auto bonus =
+      static_cast<score_t>(Private::KPK_WIN_BONUS + Private::KPK_PAWN_ADVANCE_BONUS * advance);
+  return (strong == Color::White) ? bonus : static_cast<score_t>(-bonus);
+}
+
 template <typename S>
 Evaluator<S>::Evaluator() : pawnCache_(std::make_unique<Private::PawnCache<S>>()) {}
 
@@ -342,9 +358,25 @@ Evaluator<S> &Evaluator<S>::operator=(Evaluator &&) noexcept = default;
 
 template <typename S>
 S Evaluator<S>::evalForWhite(const Board &b, const Tag &tag) const {
+  // King and pawn versus king endgames are scored exactly from the bitbase. This is not done for
+  // coefficients, as they must remain linear in the weights
+  if constexpr (std::is_same_v<S, score_t>) {
+    const KpkResult kpk = probeKpk(b);
+    if (kpk == KpkResult::Draw) {
+      return 0;
+    }
+    if (kpk != KpkResult::NotKpk) {
+      return static_cast<score_t>(Impl(*this, b, tag).evalForWhite() + kpkWinBonus(b));
+    }
+  }
   return Impl(*this, b, tag).evalForWhite();
 }
 
+template <typename S>
+S Evaluator<S>::pieceCost(const Piece piece) {
+  return Private::Weights<S>::PSQ_COST[static_cast<size_t>(piece)];
+}
+
 // Template instantiations for all score types
 template class Evaluator<score_t>;
 template class Evaluator<Coefs>;
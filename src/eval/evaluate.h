@@ -100,6 +100,10 @@ public:
     return applyColor(evalMaterialForWhite(b, tag), b.side);
   }
 
+  // Returns the base cost of the piece `piece`, without taking its position on the board into
+  // account. It can be used as a rough estimate of material gain when capturing such piece
+  static S pieceCost(SoFCore::Piece piece);
+
 private:
   inline static S applyColor(const S &result, const SoFCore::Color c) {
     return (c == SoFCore::Color::White) ? result : -result;
@@ -0,0 +1,67 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "eval/kpk.h"
+
+#include <cstddef>
+
+#include "core/types.h"
+#include "eval/private/kpk_bitbase.h"
+#include "eval/private/kpk_index.h"
+
+namespace SoFEval::Private {
+
+using SoFCore::bitboard_t;
+using SoFCore::Color;
+using SoFCore::coord_t;
+using SoFCore::Piece;
+
+KpkResult doProbeKpk(const SoFCore::Board &b) {
+  const bitboard_t bbWhitePawns = b.bbPieces[makeCell(Color::White, Piece::Pawn)];
+  const bitboard_t bbPawns = bbWhitePawns | b.bbPieces[makeCell(Color::Black, Piece::Pawn)];
+  if (!bbPawns) {
+    return KpkResult::NotKpk;
+  }
+
+  // Transform the position, so the strong side is white and the pawn is on files from `a` to `d`
+  const Color strong = bbWhitePawns ? Color::White : Color::Black;
+  auto pawn = static_cast<coord_t>(SoFUtil::getLowest(bbPawns));
+  auto strongKing =
+      static_cast<coord_t>(SoFUtil::getLowest(b.bbPieces[makeCell(strong, Piece::King)]));
+  auto weakKing = static_cast<coord_t>(
+      SoFUtil::getLowest(b.bbPieces[makeCell(SoFCore::invert(strong), Piece::King)]));
+  if (strong == Color::Black) {
+    pawn = SoFCore::coordFlipX(pawn);
+    strongKing = SoFCore::coordFlipX(strongKing);
+    weakKing = SoFCore::coordFlipX(weakKing);
+  }
+  if (SoFCore::coordY(pawn) >= 4) {
+    pawn = SoFCore::coordFlipY(pawn);
+    strongKing = SoFCore::coordFlipY(strongKing);
+    weakKing = SoFCore::coordFlipY(weakKing);
+  }
+
+  const bool isStrongMove = b.side == strong;
+  const size_t idx =
+      kpkIndex(isStrongMove ? Color::White : Color::Black, strongKing, weakKing, pawn);
+  if (!((KPK_BITBASE[idx >> 6] >> (idx & 63)) & 1)) {
+    return KpkResult::Draw;
+  }
+  return isStrongMove ? KpkResult::Win : KpkResult::Lose;
+}
+
+}  // namespace SoFEval::Private
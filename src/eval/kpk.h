@@ -0,0 +1,45 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef SOF_EVAL_KPK_INCLUDED
+#define SOF_EVAL_KPK_INCLUDED
+
+#include "core/board.h"
+#include "util/bit.h"
+
+namespace SoFEval {
+
+// Result of probing the king and pawn versus king bitbase, from the point of view of the moving
+// side
+enum class KpkResult { NotKpk, Draw, Win, Lose };
+
+namespace Private {
+KpkResult doProbeKpk(const SoFCore::Board &b);
+}  // namespace Private
+
+// Returns the exact result of the position if it's a king and pawn versus king endgame, and
+// `KpkResult::NotKpk` otherwise
+inline KpkResult probeKpk(const SoFCore::Board &b) {
+  if (SoFUtil::popcount(b.bbAll) != 3) {
+    return KpkResult::NotKpk;
+  }
+  return Private::doProbeKpk(b);
+}
+
+}  // namespace SoFEval
+
+#endif  // SOF_EVAL_KPK_INCLUDED
@@ -21,6 +21,7 @@
 #include <cstdint>
 
 #include "eval/coefs.h"
+#include "eval/score.h"
 
 namespace SoFEval::Private {
 
@@ -41,6 +42,12 @@ constexpr coef_t KING_ZONE_COST1 = 5;
 constexpr coef_t KING_ZONE_COST2 = 4;
 constexpr coef_t KING_ZONE_COST3 = 1;
 
+// Bonus for the winning side in king and pawn versus king endgame, and additional bonus for each
+// rank the pawn has advanced. The total bonus must stay below the queen cost, so the engine still
+// prefers to promote the pawn
+constexpr score_t KPK_WIN_BONUS = 200;
+constexpr score_t KPK_PAWN_ADVANCE_BONUS = 20;
+
 }  // namespace SoFEval::Private
 
 #endif  // SOF_EVAL_PRIVATE_CONSTS_INCLUDED
@@ -0,0 +1,45 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef SOF_EVAL_PRIVATE_KPK_INDEX_INCLUDED
+#define SOF_EVAL_PRIVATE_KPK_INDEX_INCLUDED
+
+#include <cstddef>
+
+#include "core/types.h"
+
+namespace SoFEval::Private {
+
+// Number of pawn positions in the KPK bitbase. The pawn is always on files from `a` to `d` and on
+// ranks from `2` to `7`, other positions are obtained by symmetry
+constexpr size_t KPK_PAWN_POSITIONS = 24;
+
+// Total number of positions in the KPK bitbase
+constexpr size_t KPK_SIZE = 2 * KPK_PAWN_POSITIONS * 64 * 64;
+
+// Returns the index of the KPK position in the bitbase. The pawn belongs to white, and must be
+// placed as described in `KPK_PAWN_POSITIONS`
+inline constexpr size_t kpkIndex(const SoFCore::Color side, const SoFCore::coord_t whiteKing,
+                                 const SoFCore::coord_t blackKing, const SoFCore::coord_t pawn) {
+  const size_t pawnIdx = (SoFCore::coordX(pawn) - 1) * 4 + SoFCore::coordY(pawn);
+  const size_t sideIdx = (side == SoFCore::Color::White) ? 0 : 1;
+  return ((sideIdx * KPK_PAWN_POSITIONS + pawnIdx) * 64 + whiteKing) * 64 + blackKing;
+}
+
+}  // namespace SoFEval::Private
+
+#endif  // SOF_EVAL_PRIVATE_KPK_INDEX_INCLUDED
@@ -0,0 +1,29 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2020-2021 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include "core/init.h"
+
+// Boards are created from FEN in the tests, so the core must be initialized before running them
+class CoreEnvironment : public testing::Environment {
+public:
+  void SetUp() override { SoFCore::init(); }
+};
+
+static testing::Environment *const CORE_ENVIRONMENT =
+    testing::AddGlobalTestEnvironment(new CoreEnvironment);
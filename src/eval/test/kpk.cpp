@@ -0,0 +1,75 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2020-2021 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "eval/kpk.h"
+
+#include <gtest/gtest.h>
+
+#include "core/board.h"
+
+using SoFCore::Board;
+using SoFEval::KpkResult;
+using SoFEval::probeKpk;
+
+static KpkResult probe(const char *fen) { return probeKpk(Board::fromFen(fen).unwrap()); }
+
+TEST(SoFEval, Kpk_WhitePawn) {
+  // King on the sixth rank in front of the pawn wins regardless of the side to move
+  EXPECT_EQ(probe("4k3/8/4K3/4P3/8/8/8/8 w - - 0 1"), KpkResult::Win);
+  EXPECT_EQ(probe("4k3/8/4K3/4P3/8/8/8/8 b - - 0 1"), KpkResult::Lose);
+
+  // Opposition decides the result
+  EXPECT_EQ(probe("4k3/8/8/4K3/4P3/8/8/8 w - - 0 1"), KpkResult::Win);
+  EXPECT_EQ(probe("4k3/8/8/4K3/4P3/8/8/8 b - - 0 1"), KpkResult::Draw);
+  EXPECT_EQ(probe("8/8/4k3/8/4K3/4P3/8/8 w - - 0 1"), KpkResult::Draw);
+  EXPECT_EQ(probe("8/8/4k3/8/4K3/4P3/8/8 b - - 0 1"), KpkResult::Lose);
+  EXPECT_EQ(probe("8/1k6/8/1K6/1P6/8/8/8 w - - 0 1"), KpkResult::Draw);
+  EXPECT_EQ(probe("8/1k6/8/1K6/1P6/8/8/8 b - - 0 1"), KpkResult::Lose);
+
+  // Rule of the square
+  EXPECT_EQ(probe("k7/8/8/4P3/8/8/8/7K w - - 0 1"), KpkResult::Win);
+  EXPECT_EQ(probe("k7/8/8/4P3/8/8/8/7K b - - 0 1"), KpkResult::Draw);
+
+  // Rook pawns are drawn if the weak king reaches the corner
+  EXPECT_EQ(probe("k7/8/K7/P7/8/8/8/8 w - - 0 1"), KpkResult::Draw);
+  EXPECT_EQ(probe("k7/8/K7/P7/8/8/8/8 b - - 0 1"), KpkResult::Draw);
+  EXPECT_EQ(probe("7k/8/7K/7P/8/8/8/8 w - - 0 1"), KpkResult::Draw);
+  EXPECT_EQ(probe("7k/8/7K/7P/8/8/8/8 b - - 0 1"), KpkResult::Draw);
+  EXPECT_EQ(probe("5k2/8/8/8/8/8/6KP/8 w - - 0 1"), KpkResult::Draw);
+}
+
+TEST(SoFEval, Kpk_BlackPawn) {
+  EXPECT_EQ(probe("8/8/8/8/8/4k3/4p3/4K3 w - - 0 1"), KpkResult::Draw);
+  EXPECT_EQ(probe("8/8/8/8/8/4k3/4p3/4K3 b - - 0 1"), KpkResult::Win);
+  EXPECT_EQ(probe("8/8/8/8/8/3k4/4p3/4K3 w - - 0 1"), KpkResult::Lose);
+  EXPECT_EQ(probe("8/8/8/8/1k6/8/1p6/1K6 w - - 0 1"), KpkResult::Draw);
+  EXPECT_EQ(probe("8/8/8/8/1k6/8/1p6/1K6 b - - 0 1"), KpkResult::Win);
+  EXPECT_EQ(probe("7k/8/8/8/3p4/8/8/K7 b - - 0 1"), KpkResult::Draw);
+
+  EXPECT_EQ(probe("8/8/8/8/8/k7/p7/K7 w - - 0 1"), KpkResult::Draw);
+  EXPECT_EQ(probe("8/8/8/8/8/6k1/7p/7K w - - 0 1"), KpkResult::Draw);
+  EXPECT_EQ(probe("8/7p/6k1/8/8/8/8/5K2 w - - 0 1"), KpkResult::Draw);
+  EXPECT_EQ(probe("8/7p/6k1/8/8/8/8/5K2 b - - 0 1"), KpkResult::Draw);
+}
+
+TEST(SoFEval, Kpk_NotKpk) {
+  EXPECT_EQ(probe("8/8/8/8/8/8/8/k1K4N w - - 0 1"), KpkResult::NotKpk);
+  EXPECT_EQ(probe("8/8/8/8/8/8/8/k1K4R b - - 0 1"), KpkResult::NotKpk);
+  EXPECT_EQ(probe("4k3/8/8/8/8/8/8/4K3 w - - 0 1"), KpkResult::NotKpk);
+  EXPECT_EQ(probe("4k3/8/8/4P3/4P3/8/8/4K3 w - - 0 1"), KpkResult::NotKpk);
+  EXPECT_EQ(probe("4k3/4p3/8/8/8/8/4P3/4K3 w - - 0 1"), KpkResult::NotKpk);
+}
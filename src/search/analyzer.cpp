@@ -0,0 +1,139 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "search/analyzer.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+
+#include "bot_api/server.h"
+#include "search/private/job_runner.h"
+#include "search/private/limits.h"
+#include "search/private/types.h"
+#include "util/misc.h"
+
+namespace SoFSearch {
+
+using SoFBotApi::ApiResult;
+using SoFCore::Move;
+using std::chrono::steady_clock;
+
+// Server which collects the results reported by `JobRunner`
+class Analyzer::Impl final : public SoFBotApi::Server {
+public:
+  Impl(const size_t hashSize, const size_t threads, std::shared_ptr<ThreadBudget> budget)
+      : runner_(*this, std::move(budget)) {
+    runner_.setHashSize(hashSize);
+    runner_.setNumJobs(threads);
+  }
+
+  AnalysisResult analyze(const SoFCore::Board &board, const std::vector<Move> &moves,
+                         const AnalysisLimits &limits) {
+    SOF_ASSERT_MSG("No limits are set",
+                   limits.depth != 0 || limits.nodes != 0 || limits.time.count() != 0);
+    Private::SearchLimits searchLimits;
+    if (limits.depth != 0) {
+      searchLimits.depth = limits.depth;
+    }
+    if (limits.nodes != 0) {
+      searchLimits.nodes = limits.nodes;
+    }
+    if (limits.time.count() != 0) {
+      searchLimits.time = limits.time;
+    }
+
+    std::unique_lock guard(lock_);
+    result_ = AnalysisResult{{}, Move::null(), 0, {}};
+    finished_ = false;
+    startTime_ = steady_clock::now();
+    guard.unlock();
+    runner_.start(Private::Position::from(board, moves), searchLimits);
+    guard.lock();
+    event_.wait(guard, [&]() { return finished_; });
+    result_.time = sinceStart(finishTime_);
+    return std::move(result_);
+  }
+
+  void clearHash() { runner_.clearHash(); }
+
+  ApiResult finishSearch(const Move bestMove) override {
+    std::unique_lock guard(lock_);
+    finishTime_ = steady_clock::now();
+    result_.bestMove = bestMove;
+    finished_ = true;
+    guard.unlock();
+    event_.notify_all();
+    return ApiResult::Ok;
+  }
+
+  ApiResult sendString(const char *) override { return ApiResult::Ok; }
+
+  ApiResult sendResult(const SoFBotApi::SearchResult &result, const uint64_t nodes) override {
+    std::lock_guard guard(lock_);
+    result_.lines.push_back({result, nodes, sinceStart(steady_clock::now())});
+    result_.nodes = std::max(result_.nodes, nodes);
+    return ApiResult::Ok;
+  }
+
+  ApiResult sendNodeCount(const uint64_t nodes) override {
+    std::lock_guard guard(lock_);
+    result_.nodes = std::max(result_.nodes, nodes);
+    return ApiResult::Ok;
+  }
+
+  ApiResult sendHashHits(uint64_t) override { return ApiResult::Ok; }
+  ApiResult sendHashFull(SoFBotApi::permille_t) override { return ApiResult::Ok; }
+  ApiResult sendCurrMove(Move, size_t) override { return ApiResult::Ok; }
+  ApiResult reportError(const char *) override { return ApiResult::Ok; }
+
+protected:
+  // The server is not connected to any client, as `JobRunner` is used directly
+  ApiResult connect(SoFBotApi::Client *) override { return ApiResult::Ok; }
+  void disconnect() override {}
+
+private:
+  std::chrono::microseconds sinceStart(const steady_clock::time_point time) const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(time - startTime_);
+  }
+
+  std::mutex lock_;
+  std::condition_variable event_;
+  bool finished_ = false;
+  steady_clock::time_point startTime_;
+  steady_clock::time_point finishTime_;
+  AnalysisResult result_{{}, Move::null(), 0, {}};
+
+  // Declared last, so the job runner is destroyed (and joined) before the other members
+  Private::JobRunner runner_;
+};
+
+Analyzer::Analyzer(const size_t hashSize, const size_t threads,
+                   std::shared_ptr<ThreadBudget> budget)
+    : impl_(std::make_unique<Impl>(hashSize, threads, std::move(budget))) {}
+
+Analyzer::~Analyzer() = default;
+
+AnalysisResult Analyzer::analyze(const SoFCore::Board &board, const std::vector<Move> &moves,
+                                 const AnalysisLimits &limits) {
+  return impl_->analyze(board, moves, limits);
+}
+
+void Analyzer::clearHash() { impl_->clearHash(); }
+
+}  // namespace SoFSearch
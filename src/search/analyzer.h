@@ -0,0 +1,88 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef SOF_SEARCH_ANALYZER_INCLUDED
+#define SOF_SEARCH_ANALYZER_INCLUDED
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "bot_api/types.h"
+#include "core/board.h"
+#include "core/move.h"
+#include "search/thread_budget.h"
+#include "util/no_copy_move.h"
+
+namespace SoFSearch {
+
+// Limits for `Analyzer::analyze()`. Zero values mean that the corresponding limit is not set. At
+// least one of the limits must be set
+struct AnalysisLimits {
+  size_t depth = 0;
+  uint64_t nodes = 0;
+  std::chrono::milliseconds time = std::chrono::milliseconds::zero();
+};
+
+// PV line reported by the search, together with the number of nodes and the time passed since the
+// start of the search at the moment when it was reported
+struct AnalysisLine {
+  SoFBotApi::SearchResult result;
+  uint64_t nodes;
+  std::chrono::microseconds time;
+};
+
+// Result of `Analyzer::analyze()`
+struct AnalysisResult {
+  // All the PV lines reported by the search, in the order of reporting. Empty if the search didn't
+  // complete even the first iteration
+  std::vector<AnalysisLine> lines;
+  SoFCore::Move bestMove;
+  uint64_t nodes;
+  std::chrono::microseconds time;
+};
+
+// Runs the searches synchronously, without UCI or any other `SoFBotApi::Server`. Each instance owns
+// its own search threads and hash table. This class is not thread-safe, but different instances
+// may be used from different threads simultaneously
+class Analyzer : public SoFUtil::NoCopyMove {
+public:
+  // Creates the analyzer with hash table of `hashSize` bytes, which runs `threads` search threads.
+  // If `budget` is not `nullptr`, then the threads are taken from `budget`
+  Analyzer(size_t hashSize, size_t threads, std::shared_ptr<ThreadBudget> budget = nullptr);
+  ~Analyzer();
+
+  // Analyzes the position obtained from `board` by making `moves`, and waits until the search
+  // finishes. The hash table is kept between the calls, so call `clearHash()` if the searches must
+  // be independent
+  AnalysisResult analyze(const SoFCore::Board &board, const std::vector<SoFCore::Move> &moves,
+                         const AnalysisLimits &limits);
+
+  // Clears the hash table
+  void clearHash();
+
+private:
+  class Impl;
+
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace SoFSearch
+
+#endif  // SOF_SEARCH_ANALYZER_INCLUDED
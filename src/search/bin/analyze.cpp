@@ -0,0 +1,222 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <json/json.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "bot_api/types.h"
+#include "core/board.h"
+#include "core/epd.h"
+#include "core/init.h"
+#include "core/strutil.h"
+#include "search/analyzer.h"
+#include "util/ioutil.h"
+#include "util/misc.h"
+#include "util/optparse.h"
+#include "util/result.h"
+#include "util/strutil.h"
+
+using SoFBotApi::PositionCostBound;
+using SoFBotApi::PositionCostType;
+using SoFCore::Board;
+using SoFSearch::AnalysisLimits;
+using SoFSearch::AnalysisResult;
+using SoFSearch::Analyzer;
+using SoFUtil::panic;
+
+// Position read from the input file
+struct InputPosition {
+  size_t index;
+  std::string fen;
+  std::optional<std::string> id;
+  Board board;
+};
+
+// Parses the line of the input file, which contains either FEN or EPD record. Returns
+// `std::nullopt` if the line is empty or is a comment
+static std::optional<InputPosition> parsePosition(const size_t index, const std::string &line) {
+  const std::optional<SoFCore::EpdRecord> record =
+      SoFCore::EpdRecord::parse(line).okOrErr([&](const auto err) {
+        panic("Line " + std::to_string(index + 1) + ": " + err);
+      });
+  if (!record) {
+    return std::nullopt;
+  }
+  InputPosition position{index, record->fen, std::nullopt, record->board};
+  if (const SoFCore::EpdOperation *id = record->find("id"); id && !id->operands.empty()) {
+    position.id = id->operands.front();
+  }
+  return position;
+}
+
+static Json::Value toJson(const InputPosition &position, const AnalysisResult &result) {
+  Json::Value json(Json::objectValue);
+  json["index"] = static_cast<Json::UInt64>(position.index);
+  if (position.id) {
+    json["id"] = *position.id;
+  }
+  json["fen"] = position.fen;
+  json["bestmove"] = SoFCore::moveToStr(result.bestMove);
+  if (!result.lines.empty()) {
+    const SoFBotApi::SearchResult &line = result.lines.back().result;
+    json["depth"] = static_cast<Json::UInt64>(line.depth);
+    Json::Value &score = json["score"] = Json::Value(Json::objectValue);
+    if (line.cost.type() == PositionCostType::Centipawns) {
+      score["cp"] = line.cost.centipawns();
+    } else {
+      score["mate"] = line.cost.checkMate();
+    }
+    if (line.bound != PositionCostBound::Exact) {
+      score["bound"] = line.bound == PositionCostBound::Lowerbound ? "lower" : "upper";
+    }
+    Json::Value &pv = json["pv"] = Json::Value(Json::arrayValue);
+    for (const SoFCore::Move move : line.pv) {
+      pv.append(SoFCore::moveToStr(move));
+    }
+  }
+  json["nodes"] = static_cast<Json::UInt64>(result.nodes);
+  json["time_us"] = static_cast<Json::Int64>(result.time.count());
+  return json;
+}
+
+// Reads the positions from the input, analyzes them in parallel and writes the results. The
+// results are written in the order of completion, so they contain the index of the position
+class BatchRunner {
+public:
+  BatchRunner(std::istream &in, std::ostream &out, const AnalysisLimits &limits)
+      : in_(in), out_(out), limits_(limits) {
+    writerBuilder_["indentation"] = "";
+  }
+
+  void run(const size_t jobs, const size_t hashSize) {
+    std::vector<std::thread> threads;
+    threads.reserve(jobs);
+    for (size_t i = 0; i < jobs; ++i) {
+      threads.emplace_back([this, hashSize]() { runWorker(hashSize); });
+    }
+    for (std::thread &thread : threads) {
+      thread.join();
+    }
+  }
+
+private:
+  void runWorker(const size_t hashSize) {
+    Analyzer analyzer(hashSize, 1);
+    while (std::optional<InputPosition> position = nextPosition()) {
+      // The positions are independent, so the results must not depend on the previous searches
+      analyzer.clearHash();
+      const AnalysisResult result = analyzer.analyze(position->board, {}, limits_);
+      const std::string json = Json::writeString(writerBuilder_, toJson(*position, result));
+      std::lock_guard guard(outLock_);
+      out_ << json << "\n";
+    }
+  }
+
+  std::optional<InputPosition> nextPosition() {
+    std::lock_guard guard(inLock_);
+    std::string line;
+    while (std::getline(in_, line)) {
+      const size_t index = lineIndex_++;
+      if (auto position = parsePosition(index, SoFUtil::trimmed(line))) {
+        return position;
+      }
+    }
+    return std::nullopt;
+  }
+
+  std::mutex inLock_;
+  std::istream &in_;
+  size_t lineIndex_ = 0;
+
+  std::mutex outLock_;
+  std::ostream &out_;
+
+  const AnalysisLimits limits_;
+  Json::StreamWriterBuilder writerBuilder_;
+};
+
+constexpr const char *DESCRIPTION =
+    "Analyzes the positions from the file with FEN or EPD records (one per line) and writes the "
+    "results as JSON lines. The positions are analyzed in parallel, each one by a single-threaded "
+    "search with a cleared hash table. The results are written in the order of completion, and "
+    "\"index\" field contains the zero-based line number of the position. At least one of the "
+    "limits (depth, nodes or time) must be specified.";
+
+constexpr const char *INPUT_DESCRIPTION = "File with positions";
+constexpr const char *OUTPUT_DESCRIPTION = "Output file. If not specified, stdout is used";
+constexpr const char *DEPTH_DESCRIPTION = "Search depth";
+constexpr const char *NODES_DESCRIPTION = "Number of nodes to search";
+constexpr const char *TIME_DESCRIPTION = "Search time in milliseconds";
+constexpr const char *JOBS_DESCRIPTION =
+    "Number of positions analyzed in parallel. If zero, the number of CPU cores is used";
+constexpr const char *HASH_DESCRIPTION = "Hash table size for each job in megabytes";
+
+int main(int argc, char **argv) {
+  SoFCore::init();
+
+  SoFUtil::OptParser parser(argc, argv, "Analyze for SoFCheck");
+  parser.setLongDescription(DESCRIPTION);
+  parser.addOptions()                                                                //
+      ("i,input", INPUT_DESCRIPTION, cxxopts::value<std::string>())                  //
+      ("o,output", OUTPUT_DESCRIPTION, cxxopts::value<std::string>())                //
+      ("d,depth", DEPTH_DESCRIPTION, cxxopts::value<uint32_t>()->default_value("0"))  //
+      ("n,nodes", NODES_DESCRIPTION, cxxopts::value<uint64_t>()->default_value("0"))  //
+      ("t,time", TIME_DESCRIPTION, cxxopts::value<uint64_t>()->default_value("0"))    //
+      ("j,jobs", JOBS_DESCRIPTION, cxxopts::value<uint32_t>()->default_value("0"))    //
+      ("H,hash", HASH_DESCRIPTION, cxxopts::value<uint32_t>()->default_value("16"));
+  auto options = parser.parse();
+
+  AnalysisLimits limits;
+  limits.depth = options["depth"].as<uint32_t>();
+  limits.nodes = options["nodes"].as<uint64_t>();
+  limits.time = std::chrono::milliseconds(options["time"].as<uint64_t>());
+  if (limits.depth == 0 && limits.nodes == 0 && limits.time.count() == 0) {
+    panic("No search limits specified");
+  }
+  size_t jobs = options["jobs"].as<uint32_t>();
+  if (jobs == 0) {
+    jobs = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  }
+  const size_t hashSize = static_cast<size_t>(options["hash"].as<uint32_t>()) << 20;
+
+  std::ifstream in = SoFUtil::openReadFile(options["input"].as<std::string>())
+                         .okOrErr([](const auto err) { panic(std::move(err.description)); });
+  std::ofstream outFile;
+  if (options.count("output")) {
+    outFile = SoFUtil::openWriteFile(options["output"].as<std::string>())
+                  .okOrErr([](const auto err) { panic(std::move(err.description)); });
+  }
+  std::ostream &out = outFile.is_open() ? outFile : std::cout;
+
+  BatchRunner runner(in, out, limits);
+  runner.run(jobs, hashSize);
+  out.flush();
+  return 0;
+}
@@ -0,0 +1,291 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <json/json.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/board.h"
+#include "core/epd.h"
+#include "core/init.h"
+#include "core/move.h"
+#include "core/move_parser.h"
+#include "core/strutil.h"
+#include "search/analyzer.h"
+#include "util/ioutil.h"
+#include "util/misc.h"
+#include "util/optparse.h"
+#include "util/result.h"
+#include "util/strutil.h"
+
+using SoFCore::Board;
+using SoFCore::Move;
+using SoFSearch::AnalysisLimits;
+using SoFSearch::AnalysisLine;
+using SoFSearch::AnalysisResult;
+using SoFSearch::Analyzer;
+using SoFUtil::panic;
+using std::chrono::microseconds;
+
+// Test position read from the EPD file
+struct SuitePosition {
+  size_t index;
+  std::string id;
+  std::string fen;
+  Board board;
+  std::vector<Move> bestMoves;   // Moves from "bm" operation
+  std::vector<Move> avoidMoves;  // Moves from "am" operation
+
+  // Returns `true` if `move` is a correct answer for this position
+  bool isCorrect(const Move move) const {
+    if (!bestMoves.empty() &&
+        std::find(bestMoves.begin(), bestMoves.end(), move) == bestMoves.end()) {
+      return false;
+    }
+    return std::find(avoidMoves.begin(), avoidMoves.end(), move) == avoidMoves.end();
+  }
+};
+
+// Parses the line of the EPD file. Returns `std::nullopt` if the line is empty or is a comment
+static std::optional<SuitePosition> parsePosition(const size_t index, const std::string &line) {
+  const std::string location = "Line " + std::to_string(index + 1) + ": ";
+  const std::optional<SoFCore::EpdRecord> record =
+      SoFCore::EpdRecord::parse(line).okOrErr([&](const auto err) { panic(location + err); });
+  if (!record) {
+    return std::nullopt;
+  }
+
+  SuitePosition position{index, "", record->fen, record->board, {}, {}};
+  if (const SoFCore::EpdOperation *id = record->find("id"); id && !id->operands.empty()) {
+    position.id = id->operands.front();
+  } else {
+    position.id = "#" + std::to_string(index + 1);
+  }
+  for (const SoFCore::EpdOperation &operation : record->operations) {
+    if (operation.opcode != "bm" && operation.opcode != "am") {
+      continue;
+    }
+    std::vector<Move> &moves = operation.opcode == "bm" ? position.bestMoves : position.avoidMoves;
+    for (const std::string &moveStr : operation.operands) {
+      const Move move = SoFCore::moveParseSan(moveStr, position.board);
+      if (move == Move::invalid()) {
+        panic(location + "cannot parse move \"" + moveStr + "\"");
+      }
+      moves.push_back(move);
+    }
+  }
+  if (position.bestMoves.empty() && position.avoidMoves.empty()) {
+    panic(location + "position has neither \"bm\" nor \"am\" operation");
+  }
+  return position;
+}
+
+// Outcome of the search on one test position
+struct SolveResult {
+  bool solved;
+  // Time and nodes at which the correct move first appeared and then remained the best one until
+  // the end of the search. Meaningful only if `solved` is `true`
+  microseconds time;
+  uint64_t nodes;
+  Move bestMove;
+  size_t depth;
+};
+
+static SolveResult checkSolution(const SuitePosition &position, const AnalysisResult &result) {
+  SolveResult solve{false, microseconds::zero(), 0, result.bestMove, 0};
+  const AnalysisLine *firstCorrect = nullptr;
+  for (const AnalysisLine &line : result.lines) {
+    if (line.result.pv.empty() || !position.isCorrect(line.result.pv.front())) {
+      firstCorrect = nullptr;
+    } else if (!firstCorrect) {
+      firstCorrect = &line;
+    }
+  }
+  if (!result.lines.empty()) {
+    solve.depth = result.lines.back().result.depth;
+  }
+  // The move that the engine finally plays must be correct as well
+  if (firstCorrect && position.isCorrect(result.bestMove)) {
+    solve.solved = true;
+    solve.time = firstCorrect->time;
+    solve.nodes = firstCorrect->nodes;
+  }
+  return solve;
+}
+
+static Json::Value toJson(const SuitePosition &position, const SolveResult &solve) {
+  Json::Value json(Json::objectValue);
+  json["index"] = static_cast<Json::UInt64>(position.index);
+  json["id"] = position.id;
+  json["fen"] = position.fen;
+  json["bestmove"] = SoFCore::moveToStr(solve.bestMove);
+  json["depth"] = static_cast<Json::UInt64>(solve.depth);
+  json["solved"] = solve.solved;
+  if (solve.solved) {
+    json["time_us"] = static_cast<Json::Int64>(solve.time.count());
+    json["nodes"] = static_cast<Json::UInt64>(solve.nodes);
+  }
+  return json;
+}
+
+// Collects time-to-solution statistics over the whole suite
+class SuiteStats {
+public:
+  void add(const SolveResult &solve) {
+    ++total_;
+    if (!solve.solved) {
+      return;
+    }
+    ++solved_;
+    totalTime_ += solve.time;
+    totalNodes_ += solve.nodes;
+    size_t bucket = 0;
+    while (bucket < std::size(BUCKETS) && solve.time >= BUCKETS[bucket]) {
+      ++bucket;
+    }
+    ++bucketCounts_[bucket];
+  }
+
+  void print(std::ostream &out) const {
+    out << "Solved: " << solved_ << "/" << total_;
+    if (total_ != 0) {
+      out << " (" << std::fixed << std::setprecision(1)
+          << 100.0 * static_cast<double>(solved_) / static_cast<double>(total_) << "%)";
+    }
+    out << "\n";
+    if (solved_ == 0) {
+      return;
+    }
+    out << "Mean time to solution: " << totalTime_.count() / solved_ / 1000 << " ms\n";
+    out << "Mean nodes to solution: " << totalNodes_ / solved_ << "\n";
+    out << "Time to solution:\n";
+    for (size_t i = 0; i <= std::size(BUCKETS); ++i) {
+      const std::string label = i == std::size(BUCKETS)
+                                    ? ">= " + formatTime(BUCKETS[i - 1])
+                                    : "< " + formatTime(BUCKETS[i]);
+      out << "  " << std::left << std::setw(10) << label << std::right << std::setw(6)
+          << bucketCounts_[i] << "\n";
+    }
+  }
+
+private:
+  static std::string formatTime(const microseconds time) {
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(time).count();
+    return ms >= 1000 ? std::to_string(ms / 1000) + " s" : std::to_string(ms) + " ms";
+  }
+
+  static constexpr microseconds BUCKETS[] = {
+      std::chrono::milliseconds(10), std::chrono::milliseconds(100), std::chrono::seconds(1),
+      std::chrono::seconds(10)};
+
+  size_t total_ = 0;
+  size_t solved_ = 0;
+  microseconds totalTime_ = microseconds::zero();
+  uint64_t totalNodes_ = 0;
+  size_t bucketCounts_[std::size(BUCKETS) + 1] = {};
+};
+
+constexpr const char *DESCRIPTION =
+    "Runs the engine on the test suite in EPD format. Each position must contain \"bm\" (best "
+    "moves) or \"am\" (moves to avoid) operation, the moves are written in SAN. The positions are "
+    "searched one by one with a cleared hash table. The position is solved if the engine finally "
+    "plays the correct move, and the time to solution is the moment since which the correct move "
+    "stayed first in all the reported PV lines. At least one of the limits (nodes or time) must "
+    "be specified.";
+
+constexpr const char *INPUT_DESCRIPTION = "Test suite in EPD format";
+constexpr const char *OUTPUT_DESCRIPTION =
+    "Output file to write the per-position results as JSON lines";
+constexpr const char *NODES_DESCRIPTION = "Number of nodes to search for each position";
+constexpr const char *TIME_DESCRIPTION = "Search time for each position in milliseconds";
+constexpr const char *JOBS_DESCRIPTION = "Number of search threads";
+constexpr const char *HASH_DESCRIPTION = "Hash table size in megabytes";
+
+int main(int argc, char **argv) {
+  SoFCore::init();
+
+  SoFUtil::OptParser parser(argc, argv, "EPD test suite runner for SoFCheck");
+  parser.setLongDescription(DESCRIPTION);
+  parser.addOptions()                                                                //
+      ("i,input", INPUT_DESCRIPTION, cxxopts::value<std::string>())                  //
+      ("o,output", OUTPUT_DESCRIPTION, cxxopts::value<std::string>())                //
+      ("n,nodes", NODES_DESCRIPTION, cxxopts::value<uint64_t>()->default_value("0"))  //
+      ("t,time", TIME_DESCRIPTION, cxxopts::value<uint64_t>()->default_value("0"))    //
+      ("j,jobs", JOBS_DESCRIPTION, cxxopts::value<uint32_t>()->default_value("1"))    //
+      ("H,hash", HASH_DESCRIPTION, cxxopts::value<uint32_t>()->default_value("64"));
+  auto options = parser.parse();
+
+  AnalysisLimits limits;
+  limits.nodes = options["nodes"].as<uint64_t>();
+  limits.time = std::chrono::milliseconds(options["time"].as<uint64_t>());
+  if (limits.nodes == 0 && limits.time.count() == 0) {
+    panic("No search limits specified");
+  }
+  const size_t jobs = std::max<size_t>(options["jobs"].as<uint32_t>(), 1);
+  const size_t hashSize = static_cast<size_t>(options["hash"].as<uint32_t>()) << 20;
+
+  std::ifstream in = SoFUtil::openReadFile(options["input"].as<std::string>())
+                         .okOrErr([](const auto err) { panic(std::move(err.description)); });
+  std::vector<SuitePosition> positions;
+  std::string line;
+  for (size_t index = 0; std::getline(in, line); ++index) {
+    if (auto position = parsePosition(index, SoFUtil::trimmed(line))) {
+      positions.push_back(std::move(*position));
+    }
+  }
+
+  std::ofstream out;
+  Json::StreamWriterBuilder writerBuilder;
+  writerBuilder["indentation"] = "";
+  if (options.count("output")) {
+    out = SoFUtil::openWriteFile(options["output"].as<std::string>())
+              .okOrErr([](const auto err) { panic(std::move(err.description)); });
+  }
+
+  Analyzer analyzer(hashSize, jobs);
+  SuiteStats stats;
+  for (size_t i = 0; i < positions.size(); ++i) {
+    const SuitePosition &position = positions[i];
+    analyzer.clearHash();
+    const SolveResult solve = checkSolution(position, analyzer.analyze(position.board, {}, limits));
+    stats.add(solve);
+    std::cout << "[" << (i + 1) << "/" << positions.size() << "] " << position.id << ": "
+              << SoFCore::moveToStr(solve.bestMove) << ", ";
+    if (solve.solved) {
+      std::cout << "solved in " << solve.time.count() / 1000 << " ms, " << solve.nodes
+                << " nodes\n";
+    } else {
+      std::cout << "not solved\n";
+    }
+    if (out.is_open()) {
+      out << Json::writeString(writerBuilder, toJson(position, solve)) << "\n";
+    }
+  }
+  std::cout << "\n";
+  stats.print(std::cout);
+  return 0;
+}
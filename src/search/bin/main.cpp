@@ -15,8 +15,13 @@
 // You should have received a copy of the GNU General Public License
 // along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
 
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <sstream>
 #include <string>
+#include <utility>
 
 #include "bot_api/api_base.h"
 #include "bot_api/clients/uci.h"
@@ -25,6 +30,7 @@
 #include "core/init.h"
 #include "search/search.h"
 #include "util/misc.h"
+#include "util/optparse.h"
 #include "util/result.h"
 
 using SoFBotApi::Connection;
@@ -47,21 +53,73 @@ static const char BANNER[] = R"R(
   \__/  \__/  |        \__/  |  |  \__   \__  | \
 )R";
 
-int main() {
-  SoFCore::init();
+constexpr const char *BENCH_DESCRIPTION =
+    "Searches the embedded set of positions on the fixed depth and prints the total number of "
+    "nodes and the search speed. The total number of nodes is a signature of the engine: it must "
+    "stay the same unless the search or the evaluation is changed. With multiple threads, the "
+    "number of nodes depends on thread timings unless \"Deterministic\" engine option is set. The "
+    "same benchmark can be run via \"bench [stress] [depth D] [hash H] [threads T]\" UCI command";
 
-  std::cout << BANNER << std::endl;
+constexpr const char *DEPTH_DESCRIPTION =
+    "Search depth (default is 10, or 5 if --stress is specified)";
+constexpr const char *STRESS_DESCRIPTION =
+    "Search the pathological positions with many pieces attacking each other instead. These "
+    "positions check that the quiescense search doesn't explode";
+constexpr const char *HASH_DESCRIPTION = "Hash table size in megabytes";
+constexpr const char *THREADS_DESCRIPTION = "Number of search threads";
+
+// Creates the connection between the engine and the UCI server
+static Connection makeConnection(std::unique_ptr<SoFBotApi::ServerConnector> server) {
+  return Connection::clientSide(SoFSearch::makeEngine(), std::move(server))
+      .okOrErr([](const auto err) {
+        panic(std::string("Unable to initialize the engine: ") + SoFBotApi::apiResultToStr(err));
+      });
+}
 
-  Connection connection =
-      Connection::clientSide(SoFSearch::makeEngine(), SoFBotApi::Clients::makeUciServerConnector())
-          .okOrErr([](const auto err) {
-            panic(std::string("Unable to initialize the engine: ") +
-                  SoFBotApi::apiResultToStr(err));
-          });
+static void runPollLoop(Connection &connection) {
   const PollResult res = connection.runPollLoop();
   if (res != PollResult::Ok) {
     panic(std::string("Fatal error while processing commands: ") + pollResultToStr(res));
   }
+}
+
+// Runs "sofcheck bench" command. `argv[0]` is "bench"
+static void runBench(const int argc, const char *const *argv) {
+  SoFUtil::OptParser parser(argc, argv, "Benchmark for SoFCheck");
+  parser.setLongDescription(BENCH_DESCRIPTION);
+  parser.addOptions()  //
+      ("d,depth", DEPTH_DESCRIPTION, cxxopts::value<uint32_t>())                          //
+      ("H,hash", HASH_DESCRIPTION, cxxopts::value<uint32_t>()->default_value("16"))       //
+      ("j,threads", THREADS_DESCRIPTION, cxxopts::value<uint32_t>()->default_value("1"))  //
+      ("stress", STRESS_DESCRIPTION);
+  auto options = parser.parse();
+
+  // The benchmark is implemented as UCI command, so we just pass the command to the UCI server
+  std::string command = "bench";
+  if (options.count("stress")) {
+    command += " stress";
+  }
+  if (options.count("depth")) {
+    command += " depth " + std::to_string(options["depth"].as<uint32_t>());
+  }
+  command += " hash " + std::to_string(options["hash"].as<uint32_t>()) + " threads " +
+             std::to_string(options["threads"].as<uint32_t>()) + "\nquit\n";
+  std::istringstream in(command);
+  Connection connection = makeConnection(SoFBotApi::Clients::makeUciServerConnector(in, std::cout));
+  runPollLoop(connection);
+}
+
+int main(int argc, char **argv) {
+  SoFCore::init();
+
+  if (argc >= 2 && std::strcmp(argv[1], "bench") == 0) {
+    runBench(argc - 1, argv + 1);
+    return 0;
+  }
+
+  std::cout << BANNER << std::endl;
 
+  Connection connection = makeConnection(SoFBotApi::Clients::makeUciServerConnector());
+  runPollLoop(connection);
   return 0;
 }
@@ -0,0 +1,370 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <queue>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "core/board.h"
+#include "core/init.h"
+#include "core/move.h"
+#include "core/polyglot.h"
+#include "gameset/reader.h"
+#include "gameset/types.h"
+#include "search/private/book.h"
+#include "util/ioutil.h"
+#include "util/misc.h"
+#include "util/optparse.h"
+#include "util/result.h"
+
+using SoFCore::Board;
+using SoFCore::Move;
+using SoFGameSet::Winner;
+using SoFSearch::Private::BookEntry;
+using SoFUtil::panic;
+
+// Statistics for the move `move` from the position with key `key`. `points` are counted from the
+// point of view of the moving side, with two points for a win and one point for a draw. In the
+// temporary files, each entry takes `SIZE` bytes, with all the fields stored in little-endian
+struct MoveStats {
+  uint64_t key;
+  uint32_t games;
+  uint32_t points;
+  uint16_t move;
+
+  static constexpr size_t SIZE = 18;
+
+  // Reads the entry from `SIZE` bytes starting from `data`
+  static MoveStats read(const unsigned char *data);
+
+  // Writes the entry into `SIZE` bytes starting from `data`
+  void write(unsigned char *data) const;
+
+  inline bool sameMove(const MoveStats &o) const { return key == o.key && move == o.move; }
+
+  inline friend bool operator<(const MoveStats &a, const MoveStats &b) {
+    return a.key != b.key ? a.key < b.key : a.move < b.move;
+  }
+
+  inline friend bool operator>(const MoveStats &a, const MoveStats &b) { return b < a; }
+};
+
+template <typename T>
+inline static T readLittleEndian(const unsigned char *data) {
+  T result = 0;
+  for (size_t i = sizeof(T); i-- > 0;) {
+    result = static_cast<T>((result << 8) | data[i]);
+  }
+  return result;
+}
+
+template <typename T>
+inline static void writeLittleEndian(unsigned char *data, T value) {
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    data[i] = static_cast<unsigned char>(value & 0xff);
+    value = static_cast<T>(value >> 8);
+  }
+}
+
+MoveStats MoveStats::read(const unsigned char *data) {
+  return MoveStats{readLittleEndian<uint64_t>(data), readLittleEndian<uint32_t>(data + 8),
+                   readLittleEndian<uint32_t>(data + 12), readLittleEndian<uint16_t>(data + 16)};
+}
+
+void MoveStats::write(unsigned char *data) const {
+  writeLittleEndian(data, key);
+  writeLittleEndian(data + 8, games);
+  writeLittleEndian(data + 12, points);
+  writeLittleEndian(data + 16, move);
+}
+
+// Opens the file `path` in binary mode, as `SoFUtil::openReadFile()` and
+// `SoFUtil::openWriteFile()` open the files only in text mode
+template <typename F>
+static F openBinaryFile(const std::string &path) {
+  F file(path, std::ios::binary);
+  if (!file.is_open()) {
+    panic("Unable to open file \"" + path + "\"");
+  }
+  return file;
+}
+
+// Sorts `stats` and merges the entries for the same moves
+static void sortAndMerge(std::vector<MoveStats> &stats) {
+  std::sort(stats.begin(), stats.end());
+  size_t size = 0;
+  for (const MoveStats &cur : stats) {
+    if (size != 0 && stats[size - 1].sameMove(cur)) {
+      stats[size - 1].games += cur.games;
+      stats[size - 1].points += cur.points;
+    } else {
+      stats[size++] = cur;
+    }
+  }
+  stats.resize(size);
+}
+
+// Collects the move statistics from the games. As there may be too many positions to keep them in
+// memory, the statistics are sorted in chunks and dumped into temporary files (runs). The runs are
+// merged when the book is written
+class BookBuilder {
+public:
+  BookBuilder(std::string tmpPrefix, const size_t maxPly, const size_t bufferSize)
+      : tmpPrefix_(std::move(tmpPrefix)), maxPly_(maxPly), bufferSize_(bufferSize) {
+    buffer_.reserve(bufferSize_);
+  }
+
+  ~BookBuilder() {
+    for (const std::string &path : runs_) {
+      std::remove(path.c_str());
+    }
+  }
+
+  void addGame(const SoFGameSet::Game &game) {
+    if (game.header.winner == Winner::Unknown) {
+      ++skippedGames_;
+      return;
+    }
+    ++games_;
+    std::optional<Board> board;
+    for (const SoFGameSet::InnerCommand &command : game.commands) {
+      if (const auto *boardCommand = std::get_if<SoFGameSet::BoardCommand>(&command)) {
+        board = *boardCommand->board;
+        continue;
+      }
+      for (const Move move : std::get<SoFGameSet::MovesCommand>(command).moves) {
+        if (ply(*board) >= maxPly_) {
+          break;
+        }
+        add(MoveStats{SoFCore::polyglotKey(*board), 1, points(game.header.winner, board->side),
+                      SoFCore::polyglotMoveEncode(*board, move)});
+        SoFCore::moveMake(*board, move);
+      }
+    }
+  }
+
+  // Merges all the collected statistics and writes the book into `out`. Only the moves played in
+  // at least `minGames` games are written
+  void write(std::ostream &out, const uint32_t minGames) {
+    flush();
+    std::vector<std::ifstream> runs;
+    for (const std::string &path : runs_) {
+      runs.push_back(openBinaryFile<std::ifstream>(path));
+    }
+
+    // Merge the runs, keeping the smallest entry of each run in the heap
+    using HeapItem = std::pair<MoveStats, size_t>;
+    std::priority_queue<HeapItem, std::vector<HeapItem>, std::greater<>> heap;
+    for (size_t i = 0; i < runs.size(); ++i) {
+      if (auto stats = readStats(runs[i])) {
+        heap.emplace(*stats, i);
+      }
+    }
+    std::vector<MoveStats> position;
+    while (!heap.empty()) {
+      const auto [stats, run] = heap.top();
+      heap.pop();
+      if (auto next = readStats(runs[run])) {
+        heap.emplace(*next, run);
+      }
+      if (!position.empty() && position.back().key != stats.key) {
+        writePosition(out, position, minGames);
+        position.clear();
+      }
+      if (!position.empty() && position.back().sameMove(stats)) {
+        position.back().games += stats.games;
+        position.back().points += stats.points;
+      } else {
+        position.push_back(stats);
+      }
+    }
+    writePosition(out, position, minGames);
+  }
+
+  uint64_t games() const { return games_; }
+  uint64_t skippedGames() const { return skippedGames_; }
+  uint64_t entries() const { return entries_; }
+  size_t runCount() const { return runs_.size(); }
+
+private:
+  // Returns the number of plies since the start of the game
+  static size_t ply(const Board &board) {
+    return 2 * static_cast<size_t>(std::max<uint16_t>(board.moveNumber, 1) - 1) +
+           (board.side == SoFCore::Color::Black ? 1 : 0);
+  }
+
+  static uint32_t points(const Winner winner, const SoFCore::Color side) {
+    if (winner == Winner::Draw) {
+      return 1;
+    }
+    const bool whiteWins = winner == Winner::White;
+    return whiteWins == (side == SoFCore::Color::White) ? 2 : 0;
+  }
+
+  static std::optional<MoveStats> readStats(std::ifstream &in) {
+    unsigned char data[MoveStats::SIZE];
+    if (!in.read(reinterpret_cast<char *>(data), MoveStats::SIZE)) {
+      return std::nullopt;
+    }
+    return MoveStats::read(data);
+  }
+
+  void add(const MoveStats &stats) {
+    buffer_.push_back(stats);
+    if (buffer_.size() == bufferSize_) {
+      flush();
+    }
+  }
+
+  // Sorts the buffered statistics and dumps them into a new run
+  void flush() {
+    if (buffer_.empty()) {
+      return;
+    }
+    sortAndMerge(buffer_);
+    const std::string path = tmpPrefix_ + std::to_string(runs_.size());
+    auto out = openBinaryFile<std::ofstream>(path);
+    runs_.push_back(path);
+    for (const MoveStats &stats : buffer_) {
+      unsigned char data[MoveStats::SIZE];
+      stats.write(data);
+      out.write(reinterpret_cast<const char *>(data), MoveStats::SIZE);
+    }
+    if (!out) {
+      panic("Cannot write to \"" + path + "\"");
+    }
+    buffer_.clear();
+  }
+
+  // Writes the book entries for one position. The weight of each move is the number of points
+  // scored with it, scaled down to fit into 16 bits if necessary
+  void writePosition(std::ostream &out, const std::vector<MoveStats> &position,
+                     const uint32_t minGames) {
+    uint32_t maxPoints = 0;
+    for (const MoveStats &stats : position) {
+      if (stats.games >= minGames) {
+        maxPoints = std::max(maxPoints, stats.points);
+      }
+    }
+    for (const MoveStats &stats : position) {
+      if (stats.games < minGames) {
+        continue;
+      }
+      uint64_t weight = stats.points;
+      if (maxPoints > UINT16_MAX) {
+        weight = weight * UINT16_MAX / maxPoints;
+      }
+      unsigned char data[BookEntry::SIZE];
+      BookEntry{stats.key, stats.move, static_cast<uint16_t>(weight), 0}.write(data);
+      out.write(reinterpret_cast<const char *>(data), BookEntry::SIZE);
+      ++entries_;
+    }
+  }
+
+  const std::string tmpPrefix_;
+  const size_t maxPly_;
+  const size_t bufferSize_;
+  std::vector<MoveStats> buffer_;
+  std::vector<std::string> runs_;
+  uint64_t games_ = 0;
+  uint64_t skippedGames_ = 0;
+  uint64_t entries_ = 0;
+};
+
+constexpr const char *DESCRIPTION =
+    "Builds the opening book in Polyglot format from the games in SoFGameSet format. For each "
+    "position up to the given ply, the tool counts the games and the points scored with each move "
+    "(two for a win and one for a draw, from the point of view of the moving side). The weight of "
+    "the move in the book is the number of points. The games with unknown result are skipped. To "
+    "handle large game archives, the statistics are sorted in chunks of limited size and dumped "
+    "into temporary files, which are merged in the end.";
+
+constexpr const char *INPUT_DESCRIPTION =
+    "Input files with games. Can be specified multiple times";
+constexpr const char *OUTPUT_DESCRIPTION = "Output book file";
+constexpr const char *PLY_DESCRIPTION = "Maximum ply of the positions in the book";
+constexpr const char *MIN_GAMES_DESCRIPTION =
+    "Minimum number of games in which the move must be played to get into the book";
+constexpr const char *MEMORY_DESCRIPTION = "Memory limit for the sorted chunks in megabytes";
+constexpr const char *TMP_DESCRIPTION =
+    "Prefix for the temporary files. If not specified, the output file name is used";
+
+int main(int argc, char **argv) {
+  SoFCore::init();
+
+  SoFUtil::OptParser parser(argc, argv, "Opening book builder for SoFCheck");
+  parser.setLongDescription(DESCRIPTION);
+  parser.addOptions()                                                                        //
+      ("i,input", INPUT_DESCRIPTION, cxxopts::value<std::vector<std::string>>())             //
+      ("o,output", OUTPUT_DESCRIPTION, cxxopts::value<std::string>())                        //
+      ("p,ply", PLY_DESCRIPTION, cxxopts::value<uint32_t>()->default_value("24"))            //
+      ("g,min-games", MIN_GAMES_DESCRIPTION, cxxopts::value<uint32_t>()->default_value("1"))  //
+      ("m,memory", MEMORY_DESCRIPTION, cxxopts::value<uint32_t>()->default_value("512"))     //
+      ("tmp", TMP_DESCRIPTION, cxxopts::value<std::string>());
+  auto options = parser.parse();
+
+  if (!options.count("input") || !options.count("output")) {
+    panic("Both input and output files must be specified");
+  }
+  const std::string outPath = options["output"].as<std::string>();
+  const std::string tmpPrefix =
+      (options.count("tmp") ? options["tmp"].as<std::string>() : outPath) + ".run";
+  const size_t bufferSize =
+      std::max<size_t>((static_cast<size_t>(options["memory"].as<uint32_t>()) << 20) /
+                           sizeof(MoveStats),
+                       1);
+
+  BookBuilder builder(tmpPrefix, options["ply"].as<uint32_t>(), bufferSize);
+  for (const std::string &path : options["input"].as<std::vector<std::string>>()) {
+    std::ifstream in = SoFUtil::openReadFile(path).okOrErr(
+        [](const auto err) { panic(std::move(err.description)); });
+    SoFGameSet::GameReader reader(in);
+    for (;;) {
+      auto readResult = reader.nextGame();
+      if (readResult.isErr()) {
+        const auto &error = readResult.err();
+        if (error.status == SoFGameSet::GameReader::Error::Status::EndOfStream) {
+          break;
+        }
+        panic(path + ": line " + std::to_string(error.line) + ": " + error.message);
+      }
+      builder.addGame(std::move(readResult).unwrap());
+    }
+  }
+
+  auto out = openBinaryFile<std::ofstream>(outPath);
+  builder.write(out, options["min-games"].as<uint32_t>());
+  out.flush();
+  if (!out) {
+    panic("Cannot write to \"" + outPath + "\"");
+  }
+
+  std::cerr << "Processed " << builder.games() << " games (" << builder.skippedGames()
+            << " skipped) in " << builder.runCount() << " runs, written " << builder.entries()
+            << " book entries" << std::endl;
+  return 0;
+}
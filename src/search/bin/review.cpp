@@ -0,0 +1,355 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <json/json.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "bot_api/types.h"
+#include "core/board.h"
+#include "core/init.h"
+#include "core/move.h"
+#include "core/move_parser.h"
+#include "core/movegen.h"
+#include "core/strutil.h"
+#include "gameset/reader.h"
+#include "gameset/types.h"
+#include "search/analyzer.h"
+#include "util/ioutil.h"
+#include "util/misc.h"
+#include "util/optparse.h"
+#include "util/result.h"
+#include "util/strutil.h"
+
+using SoFBotApi::PositionCost;
+using SoFBotApi::PositionCostType;
+using SoFCore::Board;
+using SoFCore::Move;
+using SoFSearch::AnalysisLimits;
+using SoFSearch::AnalysisResult;
+using SoFSearch::Analyzer;
+using SoFUtil::panic;
+
+// Part of the game which starts from `board` and continues with `moves`
+struct GameSegment {
+  Board board;
+  std::vector<Move> moves;
+};
+
+// Position in the reviewed game, which is obtained by applying the first `moveCount` moves of the
+// segment to its board
+struct ReviewPosition {
+  size_t segment;
+  size_t moveCount;
+};
+
+// Analysis of one position
+struct PositionReport {
+  std::optional<PositionCost> score;
+  Move bestMove;
+  size_t depth;
+  uint64_t nodes;
+  std::chrono::microseconds time;
+};
+
+// Converts the score of the position after the move into the score of this move for the side which
+// made it
+static PositionCost scoreBeforeMove(const PositionCost after) {
+  if (after.type() == PositionCostType::Centipawns) {
+    return PositionCost::centipawns(-after.centipawns());
+  }
+  const int16_t moves = after.checkMate();
+  return PositionCost::checkMate(static_cast<int16_t>(moves <= 0 ? 1 - moves : -moves));
+}
+
+static Json::Value scoreToJson(const PositionCost score) {
+  Json::Value json(Json::objectValue);
+  if (score.type() == PositionCostType::Centipawns) {
+    json["cp"] = score.centipawns();
+  } else {
+    json["mate"] = score.checkMate();
+  }
+  return json;
+}
+
+static std::vector<GameSegment> gameSegments(const SoFGameSet::Game &game) {
+  std::vector<GameSegment> segments;
+  for (const SoFGameSet::InnerCommand &command : game.commands) {
+    if (const auto *boardCommand = std::get_if<SoFGameSet::BoardCommand>(&command)) {
+      segments.push_back(GameSegment{*boardCommand->board, {}});
+    } else {
+      const auto &moves = std::get<SoFGameSet::MovesCommand>(command).moves;
+      std::vector<Move> &dst = segments.back().moves;
+      dst.insert(dst.end(), moves.begin(), moves.end());
+    }
+  }
+  return segments;
+}
+
+static bool hasLegalMoves(const Board &board) {
+  Move moves[SoFCore::BUFSZ_MOVES];
+  const size_t count = SoFCore::MoveGen(board).genAllMoves(moves);
+  for (size_t i = 0; i < count; ++i) {
+    if (SoFCore::isMoveLegal(board, moves[i])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Reviews the games, analyzing each of them from the last position to the first one. The hash table
+// is kept between the positions of one game, so the deep results obtained for the later positions
+// are reused when analyzing the earlier ones
+class GameReviewer {
+public:
+  GameReviewer(std::ostream &out, Analyzer &analyzer, const AnalysisLimits &limits,
+               const bool forward)
+      : out_(out), analyzer_(analyzer), limits_(limits), forward_(forward) {
+    writerBuilder_["indentation"] = "";
+  }
+
+  void review(const size_t gameIndex, const std::vector<GameSegment> &segments) {
+    std::vector<ReviewPosition> positions;
+    for (size_t i = 0; i < segments.size(); ++i) {
+      for (size_t count = 0; count <= segments[i].moves.size(); ++count) {
+        positions.push_back(ReviewPosition{i, count});
+      }
+    }
+
+    // The games are independent, so the results must not depend on the previous ones
+    analyzer_.clearHash();
+    std::vector<PositionReport> reports(positions.size());
+    for (size_t step = 0; step < positions.size(); ++step) {
+      const size_t idx = forward_ ? step : positions.size() - 1 - step;
+      reports[idx] = analyze(segments[positions[idx].segment], positions[idx].moveCount);
+    }
+
+    for (size_t i = 0; i < positions.size(); ++i) {
+      const GameSegment &segment = segments[positions[i].segment];
+      const size_t moveCount = positions[i].moveCount;
+      const std::optional<PositionReport> next =
+          moveCount < segment.moves.size() ? std::make_optional(reports[i + 1]) : std::nullopt;
+      const std::optional<Move> played =
+          next ? std::make_optional(segment.moves[moveCount]) : std::nullopt;
+      const std::string json = Json::writeString(
+          writerBuilder_, toJson(gameIndex, i, positionBoard(segment, moveCount), played,
+                                 reports[i], next));
+      out_ << json << "\n";
+    }
+  }
+
+  size_t positionCount() const { return positionCount_; }
+  uint64_t totalNodes() const { return totalNodes_; }
+  std::chrono::microseconds totalTime() const { return totalTime_; }
+
+private:
+  static Board positionBoard(const GameSegment &segment, const size_t moveCount) {
+    Board board = segment.board;
+    for (size_t i = 0; i < moveCount; ++i) {
+      SoFCore::moveMake(board, segment.moves[i]);
+    }
+    return board;
+  }
+
+  PositionReport analyze(const GameSegment &segment, const size_t moveCount) {
+    ++positionCount_;
+    // Do not search in the positions where the game is over, as the search returns no moves there
+    const Board board = positionBoard(segment, moveCount);
+    if (!hasLegalMoves(board)) {
+      const PositionCost score =
+          SoFCore::isCheck(board) ? PositionCost::checkMate(0) : PositionCost::centipawns(0);
+      return PositionReport{score, Move::null(), 0, 0, std::chrono::microseconds::zero()};
+    }
+
+    // Pass the moves instead of the resulting board, so the search knows the previous positions
+    const std::vector<Move> moves(segment.moves.begin(),
+                                  segment.moves.begin() + static_cast<ptrdiff_t>(moveCount));
+    const AnalysisResult result = analyzer_.analyze(segment.board, moves, limits_);
+    totalNodes_ += result.nodes;
+    totalTime_ += result.time;
+    PositionReport report{std::nullopt, result.bestMove, 0, result.nodes, result.time};
+    if (!result.lines.empty()) {
+      report.score = result.lines.back().result.cost;
+      report.depth = result.lines.back().result.depth;
+    }
+    return report;
+  }
+
+  static Json::Value toJson(const size_t gameIndex, const size_t ply, const Board &board,
+                            const std::optional<Move> played, const PositionReport &report,
+                            const std::optional<PositionReport> &next) {
+    Json::Value json(Json::objectValue);
+    json["game"] = static_cast<Json::UInt64>(gameIndex);
+    json["ply"] = static_cast<Json::UInt64>(ply);
+    json["fen"] = board.asFen();
+    if (report.bestMove != Move::null()) {
+      json["bestmove"] = SoFCore::moveToStr(report.bestMove);
+      json["depth"] = static_cast<Json::UInt64>(report.depth);
+    }
+    if (report.score) {
+      json["score"] = scoreToJson(*report.score);
+    }
+    if (played) {
+      json["move"] = SoFCore::moveToStr(*played);
+      if (next->score) {
+        const PositionCost playedScore = scoreBeforeMove(*next->score);
+        json["move_score"] = scoreToJson(playedScore);
+        if (report.score && report.score->type() == PositionCostType::Centipawns &&
+            playedScore.type() == PositionCostType::Centipawns) {
+          json["loss_cp"] = report.score->centipawns() - playedScore.centipawns();
+        }
+      }
+    }
+    json["nodes"] = static_cast<Json::UInt64>(report.nodes);
+    json["time_us"] = static_cast<Json::Int64>(report.time.count());
+    return json;
+  }
+
+  std::ostream &out_;
+  Analyzer &analyzer_;
+  const AnalysisLimits limits_;
+  const bool forward_;
+  Json::StreamWriterBuilder writerBuilder_;
+
+  size_t positionCount_ = 0;
+  uint64_t totalNodes_ = 0;
+  std::chrono::microseconds totalTime_ = std::chrono::microseconds::zero();
+};
+
+// Parses the game given as the starting position `fen` and the moves `moves` in UCI notation
+static std::vector<GameSegment> parseMoveList(const std::string &fen, const std::string &moves) {
+  GameSegment segment{Board::fromFen(fen.c_str()).okOrErr([&](const auto err) {
+                        panic("Cannot parse position \"" + fen +
+                              "\": " + SoFCore::fenParseResultToStr(err));
+                      }),
+                      {}};
+  const SoFCore::ValidateResult validateRes = segment.board.validate();
+  if (validateRes != SoFCore::ValidateResult::Ok) {
+    panic("Position \"" + fen + "\" is invalid: " + SoFCore::validateResultToStr(validateRes));
+  }
+  Board board = segment.board;
+  for (const auto &token : SoFUtil::split(moves.c_str())) {
+    const Move move = SoFCore::moveParse(token.data(), token.data() + token.size(), board);
+    if (!move.isWellFormed(board.side) || !SoFCore::isMoveValid(board, move) ||
+        !SoFCore::isMoveLegal(board, move)) {
+      panic("Move \"" + std::string(token) + "\" is illegal");
+    }
+    segment.moves.push_back(move);
+    SoFCore::moveMake(board, move);
+  }
+  return {std::move(segment)};
+}
+
+constexpr const char *DESCRIPTION =
+    "Reviews the games and writes the per-position report as JSON lines. The games are taken "
+    "either from the file in SoFGameSet format, or from the UCI move list. Each game is analyzed "
+    "backwards, from the last position to the first one, keeping the hash table between the "
+    "positions, so the deep results for the later positions speed up the analysis of the earlier "
+    "ones. The report for each position contains the score and the best move, and, if a move was "
+    "played from this position, the score of the played move and the centipawn loss. All the "
+    "scores are from the point of view of the side to move. At least one of the limits (depth, "
+    "nodes or time) must be specified, and it applies to each position separately.";
+
+constexpr const char *INPUT_DESCRIPTION = "File with games in SoFGameSet format";
+constexpr const char *MOVES_DESCRIPTION = "Game moves in UCI notation, separated by spaces";
+constexpr const char *FEN_DESCRIPTION = "Starting position for the moves given by --moves";
+constexpr const char *OUTPUT_DESCRIPTION = "Output file. If not specified, stdout is used";
+constexpr const char *DEPTH_DESCRIPTION = "Search depth for each position";
+constexpr const char *NODES_DESCRIPTION = "Number of nodes to search for each position";
+constexpr const char *TIME_DESCRIPTION = "Search time for each position in milliseconds";
+constexpr const char *JOBS_DESCRIPTION = "Number of search threads";
+constexpr const char *HASH_DESCRIPTION = "Hash table size in megabytes";
+constexpr const char *FORWARD_DESCRIPTION =
+    "Analyze the games from the first position to the last one instead (for comparison)";
+
+int main(int argc, char **argv) {
+  SoFCore::init();
+
+  SoFUtil::OptParser parser(argc, argv, "Game review for SoFCheck");
+  parser.setLongDescription(DESCRIPTION);
+  parser.addOptions()                                                                //
+      ("i,input", INPUT_DESCRIPTION, cxxopts::value<std::string>())                  //
+      ("m,moves", MOVES_DESCRIPTION, cxxopts::value<std::string>())                  //
+      ("f,fen", FEN_DESCRIPTION,
+       cxxopts::value<std::string>()->default_value(Board::initialPosition().asFen()))  //
+      ("o,output", OUTPUT_DESCRIPTION, cxxopts::value<std::string>())                   //
+      ("d,depth", DEPTH_DESCRIPTION, cxxopts::value<uint32_t>()->default_value("0"))    //
+      ("n,nodes", NODES_DESCRIPTION, cxxopts::value<uint64_t>()->default_value("0"))    //
+      ("t,time", TIME_DESCRIPTION, cxxopts::value<uint64_t>()->default_value("0"))      //
+      ("j,jobs", JOBS_DESCRIPTION, cxxopts::value<uint32_t>()->default_value("1"))      //
+      ("H,hash", HASH_DESCRIPTION, cxxopts::value<uint32_t>()->default_value("64"))     //
+      ("forward", FORWARD_DESCRIPTION);
+  auto options = parser.parse();
+
+  AnalysisLimits limits;
+  limits.depth = options["depth"].as<uint32_t>();
+  limits.nodes = options["nodes"].as<uint64_t>();
+  limits.time = std::chrono::milliseconds(options["time"].as<uint64_t>());
+  if (limits.depth == 0 && limits.nodes == 0 && limits.time.count() == 0) {
+    panic("No search limits specified");
+  }
+  if (options.count("input") == options.count("moves")) {
+    panic("Exactly one of --input and --moves must be specified");
+  }
+  const size_t jobs = std::max<size_t>(options["jobs"].as<uint32_t>(), 1);
+  const size_t hashSize = static_cast<size_t>(options["hash"].as<uint32_t>()) << 20;
+
+  std::ofstream outFile;
+  if (options.count("output")) {
+    outFile = SoFUtil::openWriteFile(options["output"].as<std::string>())
+                  .okOrErr([](const auto err) { panic(std::move(err.description)); });
+  }
+  std::ostream &out = outFile.is_open() ? outFile : std::cout;
+
+  Analyzer analyzer(hashSize, jobs);
+  GameReviewer reviewer(out, analyzer, limits, options.count("forward") != 0);
+  if (options.count("moves")) {
+    reviewer.review(0, parseMoveList(options["fen"].as<std::string>(),
+                                     options["moves"].as<std::string>()));
+  } else {
+    std::ifstream in = SoFUtil::openReadFile(options["input"].as<std::string>())
+                           .okOrErr([](const auto err) { panic(std::move(err.description)); });
+    SoFGameSet::GameReader reader(in);
+    for (size_t gameIndex = 0;; ++gameIndex) {
+      auto readResult = reader.nextGame();
+      if (readResult.isErr()) {
+        const auto &error = readResult.err();
+        if (error.status == SoFGameSet::GameReader::Error::Status::EndOfStream) {
+          break;
+        }
+        panic("Line " + std::to_string(error.line) + ": " + error.message);
+      }
+      reviewer.review(gameIndex, gameSegments(std::move(readResult).unwrap()));
+    }
+  }
+  out.flush();
+
+  std::cerr << "Reviewed " << reviewer.positionCount() << " positions: "
+            << reviewer.totalNodes() << " nodes, " << reviewer.totalTime().count() / 1000
+            << " ms" << std::endl;
+  return 0;
+}
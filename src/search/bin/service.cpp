@@ -0,0 +1,260 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "bot_api/api_base.h"
+#include "bot_api/clients/uci.h"
+#include "bot_api/connection.h"
+#include "bot_api/strutil.h"
+#include "core/init.h"
+#include "search/search.h"
+#include "search/thread_budget.h"
+#include "util/misc.h"
+#include "util/no_copy_move.h"
+#include "util/optparse.h"
+#include "util/result.h"
+#include "util/strutil.h"
+
+using SoFBotApi::Connection;
+using SoFBotApi::PollResult;
+using SoFSearch::ThreadBudget;
+using SoFUtil::panic;
+
+// Input buffer which receives the lines from another thread. Reading blocks until a new line
+// arrives or the buffer is closed
+class LineQueueBuf final : public std::streambuf, public SoFUtil::NoCopyMove {
+public:
+  // Adds the line to the buffer
+  void push(std::string line) {
+    std::unique_lock guard(lock_);
+    lines_.push_back(std::move(line) + "\n");
+    guard.unlock();
+    event_.notify_all();
+  }
+
+  // Closes the buffer. The reader gets end of file after reading all the lines
+  void close() {
+    std::unique_lock guard(lock_);
+    closed_ = true;
+    guard.unlock();
+    event_.notify_all();
+  }
+
+protected:
+  int_type underflow() override {
+    std::unique_lock guard(lock_);
+    event_.wait(guard, [&]() { return !lines_.empty() || closed_; });
+    if (lines_.empty()) {
+      return traits_type::eof();
+    }
+    current_ = std::move(lines_.front());
+    lines_.pop_front();
+    setg(current_.data(), current_.data(), current_.data() + current_.size());
+    return traits_type::to_int_type(current_[0]);
+  }
+
+private:
+  std::mutex lock_;
+  std::condition_variable event_;
+  std::deque<std::string> lines_;
+  std::string current_;
+  bool closed_ = false;
+};
+
+// Output buffer which prefixes each line with the session id and writes it to the standard output
+class PrefixOutBuf final : public std::streambuf, public SoFUtil::NoCopyMove {
+public:
+  PrefixOutBuf(std::string prefix, std::mutex &outLock)
+      : prefix_(std::move(prefix)), outLock_(outLock) {}
+
+protected:
+  int_type overflow(const int_type c) override {
+    if (traits_type::eq_int_type(c, traits_type::eof())) {
+      return traits_type::not_eof(c);
+    }
+    const char ch = traits_type::to_char_type(c);
+    if (ch != '\n') {
+      line_ += ch;
+      return c;
+    }
+    std::lock_guard guard(outLock_);
+    std::cout << prefix_ << " " << line_ << "\n";
+    line_.clear();
+    return c;
+  }
+
+  int sync() override {
+    std::lock_guard guard(outLock_);
+    std::cout.flush();
+    return 0;
+  }
+
+private:
+  std::string prefix_;
+  std::string line_;
+  std::mutex &outLock_;
+};
+
+// Single search session. It runs its own engine with UCI server connector in a separate thread
+class Session : public SoFUtil::NoCopyMove {
+public:
+  Session(const std::string &id, std::shared_ptr<ThreadBudget> budget, const int64_t hashSize,
+          std::mutex &outLock)
+      : outBuf_(id, outLock), in_(&inBuf_), out_(&outBuf_) {
+    inBuf_.push("setoption name Hash value " + std::to_string(hashSize));
+    thread_ = std::thread([this, budget = std::move(budget)]() {
+      Connection connection =
+          Connection::clientSide(SoFSearch::makeEngine(budget),
+                                 SoFBotApi::Clients::makeUciServerConnector(in_, out_))
+              .okOrErr([](const auto err) {
+                panic(std::string("Unable to initialize the engine: ") +
+                      SoFBotApi::apiResultToStr(err));
+              });
+      const PollResult res = connection.runPollLoop();
+      if (res != PollResult::Ok) {
+        out_ << "info string Fatal error while processing commands: " << pollResultToStr(res)
+             << std::endl;
+      }
+    });
+  }
+
+  // Passes the command to the session
+  void send(std::string command) { inBuf_.push(std::move(command)); }
+
+  // Stops the session and waits until it finishes
+  ~Session() {
+    inBuf_.close();
+    thread_.join();
+  }
+
+private:
+  LineQueueBuf inBuf_;
+  PrefixOutBuf outBuf_;
+  std::istream in_;
+  std::ostream out_;
+  std::thread thread_;
+};
+
+// Returns `true` if the UCI command tries to change the hash size. Such commands are rejected, as
+// the hash size is determined by the service. Option names are case-insensitive in UCI, and the
+// "name" token may be omitted, so we parse the option name in the same way as the UCI server does
+static bool isHashCommand(const std::string &command) {
+  std::istringstream tokens(command);
+  std::string token;
+  if (!(tokens >> token) || token != "setoption" || !(tokens >> token)) {
+    return false;
+  }
+  std::string name;
+  if (token != "name") {
+    name = token;
+  }
+  while (tokens >> token && token != "value") {
+    if (!name.empty()) {
+      name += ' ';
+    }
+    name += token;
+  }
+  SoFUtil::asciiToLower(name);
+  return name == "hash";
+}
+
+constexpr const char *DESCRIPTION =
+    "Runs multiple independent search sessions in one process. Each line of the standard input "
+    "has the form \"<session> <UCI command>\". The session is created when the first command for "
+    "it arrives and is closed by \"quit\" command. Each line of the output is prefixed with the "
+    "session id. All the sessions share one budget of search threads: each search gets no more "
+    "than its fair share of the threads, and waits until some threads are free if all of them are "
+    "busy. The hash table size is the same for all the sessions and cannot be changed by "
+    "\"setoption\". The hash table of the session is allocated on its first search, so the "
+    "sessions use no more than the value of \"--hash\" option in total.";
+
+constexpr const char *THREADS_DESCRIPTION =
+    "Total number of search threads. If zero, the number of CPU cores is used";
+constexpr const char *SESSIONS_DESCRIPTION = "Maximum number of sessions";
+constexpr const char *HASH_DESCRIPTION =
+    "Total hash table size in megabytes. Each session gets an equal share";
+
+int main(int argc, char **argv) {
+  SoFCore::init();
+
+  SoFUtil::OptParser parser(argc, argv, "SearchService for SoFCheck");
+  parser.setLongDescription(DESCRIPTION);
+  parser.addOptions()                                                                     //
+      ("j,threads", THREADS_DESCRIPTION, cxxopts::value<uint32_t>()->default_value("0"))    //
+      ("s,sessions", SESSIONS_DESCRIPTION, cxxopts::value<uint32_t>()->default_value("16"))  //
+      ("H,hash", HASH_DESCRIPTION, cxxopts::value<uint32_t>()->default_value("1024"));
+  auto options = parser.parse();
+
+  size_t threads = options["threads"].as<uint32_t>();
+  if (threads == 0) {
+    threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  }
+  const size_t maxSessions = std::max<uint32_t>(options["sessions"].as<uint32_t>(), 1);
+  const int64_t hashSize = std::max<int64_t>(options["hash"].as<uint32_t>() / maxSessions, 1);
+
+  auto budget = std::make_shared<ThreadBudget>(threads);
+  std::mutex outLock;
+  std::map<std::string, std::unique_ptr<Session>> sessions;
+  const auto reply = [&](const std::string &id, const std::string &message) {
+    std::lock_guard guard(outLock);
+    std::cout << id << " info string " << message << std::endl;
+  };
+
+  std::string line;
+  while (std::getline(std::cin, line)) {
+    std::istringstream tokens(line);
+    std::string id;
+    if (!(tokens >> id)) {
+      continue;
+    }
+    std::string rest;
+    std::getline(tokens, rest);
+    const std::string command(SoFUtil::trim(rest));
+    auto iter = sessions.find(id);
+    if (iter == sessions.end()) {
+      if (sessions.size() >= maxSessions) {
+        reply(id, "Too many sessions");
+        continue;
+      }
+      iter = sessions.emplace(id, std::make_unique<Session>(id, budget, hashSize, outLock)).first;
+    }
+    if (isHashCommand(command)) {
+      reply(id, "Hash size is fixed to " + std::to_string(hashSize) + " MB");
+      continue;
+    }
+    iter->second->send(command);
+    if (command == "quit") {
+      sessions.erase(iter);
+    }
+  }
+  sessions.clear();
+  return 0;
+}
@@ -0,0 +1,336 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <json/json.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "bot_api/api_base.h"
+#include "bot_api/clients/private/bench_positions.h"
+#include "bot_api/connection.h"
+#include "bot_api/connector.h"
+#include "bot_api/options.h"
+#include "bot_api/strutil.h"
+#include "core/board.h"
+#include "core/init.h"
+#include "core/move.h"
+#include "core/strutil.h"
+#include "search/search.h"
+#include "util/ioutil.h"
+#include "util/misc.h"
+#include "util/no_copy_move.h"
+#include "util/optparse.h"
+#include "util/result.h"
+#include "util/strutil.h"
+
+using SoFBotApi::ApiResult;
+using SoFBotApi::PollResult;
+using SoFCore::Board;
+using SoFCore::Move;
+using SoFUtil::panic;
+using std::chrono::steady_clock;
+
+struct Config {
+  std::vector<std::string> positions;
+  std::vector<size_t> threadCounts;
+  size_t depth;
+  int64_t hashSize;
+};
+
+// Result of the search on a single position
+struct PositionResult {
+  steady_clock::duration time;
+  uint64_t nodes;
+  Move bestMove;
+};
+
+// Results for a single thread count
+struct ThreadResult {
+  size_t threads;
+  std::vector<PositionResult> positions;
+  steady_clock::duration time = steady_clock::duration::zero();
+  uint64_t nodes = 0;
+};
+
+static double toMsec(const steady_clock::duration time) {
+  return std::chrono::duration<double, std::milli>(time).count();
+}
+
+static double ratio(const double a, const double b) { return b == 0.0 ? 0.0 : a / b; }
+
+static void checkApi(const ApiResult result, const char *what) {
+  if (result != ApiResult::Ok) {
+    panic(std::string(what) + " failed: " + SoFBotApi::apiResultToStr(result));
+  }
+}
+
+// Server which runs all the searches for the benchmark and collects their results
+class ScalingServer final : public SoFBotApi::ServerConnector, public SoFUtil::NoCopyMove {
+public:
+  explicit ScalingServer(const Config &config, std::vector<ThreadResult> &results)
+      : config_(config), results_(results) {}
+
+  ApiResult finishSearch(const Move bestMove) override {
+    std::unique_lock guard(lock_);
+    finishTime_ = steady_clock::now();
+    bestMove_ = bestMove;
+    finished_ = true;
+    guard.unlock();
+    finishEvent_.notify_all();
+    return ApiResult::Ok;
+  }
+
+  ApiResult sendString(const char *) override { return ApiResult::Ok; }
+
+  ApiResult sendResult(const SoFBotApi::SearchResult &, const uint64_t nodes) override {
+    std::lock_guard guard(lock_);
+    nodes_ = std::max(nodes_, nodes);
+    return ApiResult::Ok;
+  }
+
+  ApiResult sendNodeCount(const uint64_t nodes) override {
+    std::lock_guard guard(lock_);
+    nodes_ = std::max(nodes_, nodes);
+    return ApiResult::Ok;
+  }
+
+  ApiResult sendHashHits(uint64_t) override { return ApiResult::Ok; }
+  ApiResult sendHashFull(SoFBotApi::permille_t) override { return ApiResult::Ok; }
+  ApiResult sendCurrMove(Move, size_t) override { return ApiResult::Ok; }
+
+  ApiResult reportError(const char *message) override {
+    std::cerr << "Engine error: " << message << std::endl;
+    return ApiResult::Ok;
+  }
+
+  PollResult poll() override {
+    for (const size_t threads : config_.threadCounts) {
+      results_.push_back(runThreads(threads));
+    }
+    return PollResult::Shutdown;
+  }
+
+protected:
+  ApiResult connect(SoFBotApi::Client *client) override {
+    client_ = client;
+    return ApiResult::Ok;
+  }
+
+  void disconnect() override { client_ = nullptr; }
+
+private:
+  ThreadResult runThreads(const size_t threads) {
+    SoFBotApi::Options &options = client_->options();
+    checkApi(options.setInt("Hash", config_.hashSize), "Setting hash size");
+    checkApi(options.setInt("Threads", static_cast<int64_t>(threads)), "Setting thread count");
+    ThreadResult result{threads, {}};
+    for (const std::string &fen : config_.positions) {
+      // Each search starts with an empty hash table, otherwise the later searches will be faster
+      checkApi(options.triggerAction("Clear hash"), "Clearing hash");
+      const PositionResult position = runSearch(fen);
+      result.time += position.time;
+      result.nodes += position.nodes;
+      result.positions.push_back(position);
+    }
+    return result;
+  }
+
+  PositionResult runSearch(const std::string &fen) {
+    const Board board = Board::fromFen(fen.c_str()).okOrErr([&](const auto err) {
+      panic("Cannot parse position \"" + fen + "\": " + SoFCore::fenParseResultToStr(err));
+    });
+    checkApi(client_->setPosition(board, nullptr, 0), "Setting position");
+    std::unique_lock guard(lock_);
+    finished_ = false;
+    nodes_ = 0;
+    guard.unlock();
+    const auto startTime = steady_clock::now();
+    checkApi(client_->searchFixedDepth(config_.depth), "Starting search");
+    guard.lock();
+    finishEvent_.wait(guard, [&]() { return finished_; });
+    return PositionResult{finishTime_ - startTime, nodes_, bestMove_};
+  }
+
+  const Config &config_;
+  std::vector<ThreadResult> &results_;
+  SoFBotApi::Client *client_ = nullptr;
+
+  std::mutex lock_;
+  std::condition_variable finishEvent_;
+  bool finished_ = false;
+  steady_clock::time_point finishTime_;
+  uint64_t nodes_ = 0;
+  Move bestMove_ = Move::null();
+};
+
+static void printTable(std::ostream &out, const std::vector<ThreadResult> &results) {
+  const ThreadResult &base = results.front();
+  out << std::fixed << std::setprecision(3);
+  out << std::setw(8) << "Threads" << std::setw(14) << "Time, ms" << std::setw(14) << "Nodes"
+      << std::setw(10) << "Overhead" << std::setw(10) << "Speedup" << std::setw(12)
+      << "Efficiency" << std::setw(12) << "NPS" << "\n";
+  for (const ThreadResult &result : results) {
+    const double time = toMsec(result.time);
+    const double speedup = ratio(toMsec(base.time), time);
+    out << std::setw(8) << result.threads << std::setw(14) << std::setprecision(1) << time
+        << std::setw(14) << result.nodes << std::setprecision(3) << std::setw(10)
+        << ratio(static_cast<double>(result.nodes), static_cast<double>(base.nodes))
+        << std::setw(10) << speedup << std::setw(12)
+        << speedup / static_cast<double>(result.threads) << std::setw(12)
+        << static_cast<uint64_t>(ratio(static_cast<double>(result.nodes), time) * 1000.0)
+        << "\n";
+  }
+}
+
+static Json::Value toJson(const Config &config, const std::vector<ThreadResult> &results) {
+  const ThreadResult &base = results.front();
+  Json::Value json(Json::objectValue);
+  json["depth"] = static_cast<Json::UInt64>(config.depth);
+  json["hash"] = static_cast<Json::Int64>(config.hashSize);
+  Json::Value &positions = json["positions"] = Json::Value(Json::arrayValue);
+  for (const std::string &fen : config.positions) {
+    positions.append(fen);
+  }
+  Json::Value &items = json["results"] = Json::Value(Json::arrayValue);
+  for (const ThreadResult &result : results) {
+    Json::Value &item = items.append(Json::Value(Json::objectValue));
+    const double time = toMsec(result.time);
+    const double speedup = ratio(toMsec(base.time), time);
+    item["threads"] = static_cast<Json::UInt64>(result.threads);
+    item["time_ms"] = time;
+    item["nodes"] = static_cast<Json::UInt64>(result.nodes);
+    item["node_overhead"] =
+        ratio(static_cast<double>(result.nodes), static_cast<double>(base.nodes));
+    item["speedup"] = speedup;
+    item["efficiency"] = speedup / static_cast<double>(result.threads);
+    item["nps"] =
+        static_cast<Json::UInt64>(ratio(static_cast<double>(result.nodes), time) * 1000.0);
+    Json::Value &itemPositions = item["positions"] = Json::Value(Json::arrayValue);
+    for (size_t i = 0; i < result.positions.size(); ++i) {
+      const PositionResult &position = result.positions[i];
+      Json::Value &value = itemPositions.append(Json::Value(Json::objectValue));
+      value["time_ms"] = toMsec(position.time);
+      value["nodes"] = static_cast<Json::UInt64>(position.nodes);
+      value["speedup"] = ratio(toMsec(base.positions[i].time), toMsec(position.time));
+      value["best_move"] = SoFCore::moveToStr(position.bestMove);
+    }
+  }
+  return json;
+}
+
+static std::vector<std::string> readPositions(const std::string &fileName) {
+  std::ifstream in = SoFUtil::openReadFile(fileName).okOrErr(
+      [](const auto err) { panic(std::move(err.description)); });
+  std::vector<std::string> positions;
+  std::string line;
+  while (std::getline(in, line)) {
+    std::string fen = SoFUtil::trimmed(line);
+    if (!fen.empty() && fen[0] != '#') {
+      positions.push_back(std::move(fen));
+    }
+  }
+  if (positions.empty()) {
+    panic("No positions found in \"" + fileName + "\"");
+  }
+  return positions;
+}
+
+constexpr const char *DESCRIPTION =
+    "Measures how the search scales with the number of threads. Each position is searched to the "
+    "fixed depth with 1, 2, 4, ... threads, up to the given maximum. For each thread count, the "
+    "tool prints the total time to reach the depth, the node overhead compared to one thread, the "
+    "speedup and the efficiency (i.e. speedup divided by the number of threads). The hash table "
+    "is cleared before each search.";
+
+constexpr const char *INPUT_DESCRIPTION =
+    "File with positions in FEN format, one per line. If not specified, the positions from "
+    "\"bench\" command are used";
+constexpr const char *OUTPUT_DESCRIPTION = "JSON file to write the detailed results";
+constexpr const char *DEPTH_DESCRIPTION = "Search depth";
+constexpr const char *HASH_DESCRIPTION = "Hash table size in megabytes";
+constexpr const char *THREADS_DESCRIPTION =
+    "Maximum number of threads. If zero, the number of CPU cores is used";
+
+int main(int argc, char **argv) {
+  SoFCore::init();
+
+  SoFUtil::OptParser parser(argc, argv, "SmpScaling for SoFCheck");
+  parser.setLongDescription(DESCRIPTION);
+  parser.addOptions()                                                                 //
+      ("i,input", INPUT_DESCRIPTION, cxxopts::value<std::string>())                   //
+      ("o,output", OUTPUT_DESCRIPTION, cxxopts::value<std::string>())                 //
+      ("d,depth", DEPTH_DESCRIPTION, cxxopts::value<uint32_t>()->default_value("10"))  //
+      ("H,hash", HASH_DESCRIPTION, cxxopts::value<uint32_t>()->default_value("64"))    //
+      ("j,threads", THREADS_DESCRIPTION, cxxopts::value<uint32_t>()->default_value("0"));
+  auto options = parser.parse();
+
+  Config config;
+  if (options.count("input")) {
+    config.positions = readPositions(options["input"].as<std::string>());
+  } else {
+    const auto &positions = SoFBotApi::Clients::Private::BENCH_POSITIONS;
+    config.positions.assign(std::begin(positions), std::end(positions));
+  }
+  config.depth = options["depth"].as<uint32_t>();
+  config.hashSize = options["hash"].as<uint32_t>();
+  size_t maxThreads = options["threads"].as<uint32_t>();
+  if (maxThreads == 0) {
+    maxThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  }
+  for (size_t threads = 1; threads < maxThreads; threads *= 2) {
+    config.threadCounts.push_back(threads);
+  }
+  config.threadCounts.push_back(maxThreads);
+
+  std::vector<ThreadResult> results;
+  {
+    SoFBotApi::Connection connection =
+        SoFBotApi::Connection::clientSide(SoFSearch::makeEngine(),
+                                          std::make_unique<ScalingServer>(config, results))
+            .okOrErr([](const auto err) {
+              panic(std::string("Unable to initialize the engine: ") +
+                    SoFBotApi::apiResultToStr(err));
+            });
+    const PollResult res = connection.runPollLoop();
+    if (res != PollResult::Ok) {
+      panic(std::string("Error while running the searches: ") + pollResultToStr(res));
+    }
+  }
+
+  printTable(std::cout, results);
+  if (options.count("output")) {
+    const std::string fileName = options["output"].as<std::string>();
+    std::ofstream out = SoFUtil::openWriteFile(fileName).okOrErr(
+        [](const auto err) { panic(std::move(err.description)); });
+    out << toJson(config, results) << std::endl;
+  }
+  return 0;
+}
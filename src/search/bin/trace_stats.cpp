@@ -0,0 +1,208 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "search/private/move_picker.h"
+#include "search/private/trace.h"
+#include "util/misc.h"
+#include "util/optparse.h"
+
+using SoFSearch::Private::MOVE_PICKER_STAGE_SZ;
+using SoFSearch::Private::MovePickerStage;
+using SoFSearch::Private::TRACE_MAGIC;
+using SoFSearch::Private::TraceChunkHeader;
+using SoFSearch::Private::TraceEvent;
+using SoFSearch::Private::TraceEventKind;
+using SoFSearch::Private::TracePrune;
+using SoFSearch::Private::TraceTt;
+using SoFUtil::panic;
+
+constexpr size_t KIND_SZ = static_cast<size_t>(TraceEventKind::Max);
+constexpr size_t PRUNE_SZ = static_cast<size_t>(TracePrune::Max);
+constexpr size_t TT_SZ = static_cast<size_t>(TraceTt::Max);
+
+// Upper bounds of the buckets for cutoff move indices
+constexpr uint32_t CUTOFF_BUCKETS[] = {0, 1, 2, 3, 5, 9, 17, 33, UINT32_MAX};
+constexpr size_t CUTOFF_BUCKET_SZ = std::size(CUTOFF_BUCKETS);
+
+struct Summary {
+  uint64_t events = 0;
+  uint64_t kinds[KIND_SZ] = {};
+  uint64_t prunes[PRUNE_SZ] = {};
+  uint64_t tt[TT_SZ] = {};
+  uint64_t cutoffStages[MOVE_PICKER_STAGE_SZ] = {};
+  uint64_t cutoffIndices[CUTOFF_BUCKET_SZ] = {};
+  std::map<int32_t, uint64_t> nodesByDepth;
+  std::map<uint32_t, uint64_t> eventsByJob;
+  size_t maxIdepth = 0;
+
+  void add(const uint32_t jobId, const TraceEvent &event) {
+    ++events;
+    ++eventsByJob[jobId];
+    const auto kind = static_cast<size_t>(event.kind);
+    if (kind >= KIND_SZ) {
+      panic("Bad event kind " + std::to_string(kind));
+    }
+    ++kinds[kind];
+    maxIdepth = std::max<size_t>(maxIdepth, event.idepth);
+    switch (event.kind) {
+      case TraceEventKind::Enter:
+        ++nodesByDepth[event.depth];
+        break;
+      case TraceEventKind::Prune:
+        ++prunes[std::min<size_t>(event.arg, PRUNE_SZ - 1)];
+        break;
+      case TraceEventKind::Tt:
+        ++tt[std::min<size_t>(event.arg, TT_SZ - 1)];
+        break;
+      case TraceEventKind::Cutoff: {
+        ++cutoffStages[std::min<size_t>(event.arg, MOVE_PICKER_STAGE_SZ - 1)];
+        size_t bucket = 0;
+        while (event.index > CUTOFF_BUCKETS[bucket]) {
+          ++bucket;
+        }
+        ++cutoffIndices[bucket];
+        break;
+      }
+      default:
+        break;
+    }
+  }
+};
+
+static double percent(const uint64_t value, const uint64_t total) {
+  return total == 0 ? 0.0 : 100.0 * static_cast<double>(value) / static_cast<double>(total);
+}
+
+static void printLine(std::ostream &out, const std::string &name, const uint64_t value,
+                      const uint64_t total) {
+  out << "  " << std::left << std::setw(16) << name << std::right << std::setw(14) << value << "  "
+      << std::setw(6) << percent(value, total) << "%\n";
+}
+
+static void printSummary(std::ostream &out, const Summary &s) {
+  out << std::fixed << std::setprecision(2);
+  out << "Events: " << s.events << "\n";
+  out << "Max search depth: " << s.maxIdepth << "\n";
+
+  out << "\nEvents by kind:\n";
+  for (size_t i = 0; i < KIND_SZ; ++i) {
+    printLine(out, traceEventKindToStr(static_cast<TraceEventKind>(i)), s.kinds[i], s.events);
+  }
+
+  out << "\nEvents by job:\n";
+  for (const auto &[jobId, count] : s.eventsByJob) {
+    printLine(out, std::to_string(jobId), count, s.events);
+  }
+
+  const uint64_t nodes = s.kinds[static_cast<size_t>(TraceEventKind::Enter)];
+  out << "\nMain search nodes by remaining depth:\n";
+  for (const auto &[depth, count] : s.nodesByDepth) {
+    printLine(out, std::to_string(depth), count, nodes);
+  }
+
+  uint64_t prunes = 0;
+  for (const uint64_t count : s.prunes) {
+    prunes += count;
+  }
+  out << "\nPrune reasons:\n";
+  for (size_t i = 0; i < PRUNE_SZ; ++i) {
+    printLine(out, tracePruneToStr(static_cast<TracePrune>(i)), s.prunes[i], prunes);
+  }
+
+  const uint64_t probes = s.kinds[static_cast<size_t>(TraceEventKind::Tt)];
+  out << "\nTransposition table probes:\n";
+  for (size_t i = 0; i < TT_SZ; ++i) {
+    printLine(out, traceTtToStr(static_cast<TraceTt>(i)), s.tt[i], probes);
+  }
+
+  const uint64_t cutoffs = s.kinds[static_cast<size_t>(TraceEventKind::Cutoff)];
+  out << "\nBeta cutoffs by move picker stage:\n";
+  for (size_t i = 0; i < MOVE_PICKER_STAGE_SZ; ++i) {
+    printLine(out, movePickerStageToStr(static_cast<MovePickerStage>(i)), s.cutoffStages[i],
+              cutoffs);
+  }
+
+  out << "\nBeta cutoffs by move index:\n";
+  uint32_t lower = 0;
+  for (size_t i = 0; i < CUTOFF_BUCKET_SZ; ++i) {
+    const uint32_t upper = CUTOFF_BUCKETS[i];
+    std::string name = std::to_string(lower);
+    if (upper == UINT32_MAX) {
+      name += "+";
+    } else if (upper != lower) {
+      name += "-" + std::to_string(upper);
+    }
+    printLine(out, name, s.cutoffIndices[i], cutoffs);
+    lower = upper + 1;
+  }
+}
+
+static Summary readTrace(std::istream &in) {
+  char magic[sizeof(TRACE_MAGIC)];
+  if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, TRACE_MAGIC, sizeof(magic)) != 0) {
+    panic("The file is not a search trace");
+  }
+  Summary summary;
+  std::vector<TraceEvent> events;
+  TraceChunkHeader header{};
+  while (in.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+    events.resize(header.count);
+    const auto size = static_cast<std::streamsize>(header.count * sizeof(TraceEvent));
+    if (!in.read(reinterpret_cast<char *>(events.data()), size)) {
+      panic("The trace is truncated");
+    }
+    for (const TraceEvent &event : events) {
+      summary.add(header.jobId, event);
+    }
+  }
+  return summary;
+}
+
+constexpr const char *DESCRIPTION =
+    "Reads the search trace recorded by SoFCheck and prints its summary. To record the trace, "
+    "build the engine with USE_SEARCH_TRACE option and set \"Trace File\" engine option.";
+
+constexpr const char *INPUT_DESCRIPTION = "Trace file to read";
+
+int main(int argc, char **argv) {
+  std::ios_base::sync_with_stdio(false);
+
+  SoFUtil::OptParser parser(argc, argv, "TraceStats for SoFCheck");
+  parser.setLongDescription(DESCRIPTION);
+  parser.addOptions()  //
+      ("i,input", INPUT_DESCRIPTION, cxxopts::value<std::string>());
+  auto options = parser.parse();
+
+  const std::string fileName = options["input"].as<std::string>();
+  std::ifstream in(fileName, std::ios_base::in | std::ios_base::binary);
+  if (!in.is_open()) {
+    panic("Unable to open file \"" + fileName + "\"");
+  }
+  printSummary(std::cout, readTrace(in));
+  return 0;
+}
@@ -0,0 +1,122 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "search/private/book.h"
+
+#include <utility>
+#include <vector>
+
+#include "core/polyglot.h"
+#include "util/random.h"
+
+namespace SoFSearch::Private {
+
+using SoFCore::Board;
+using SoFCore::Move;
+using SoFUtil::IOError;
+
+template <typename T>
+inline static T readBigEndian(const unsigned char *data) {
+  T result = 0;
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    result = static_cast<T>((result << 8) | data[i]);
+  }
+  return result;
+}
+
+template <typename T>
+inline static void writeBigEndian(unsigned char *data, T value) {
+  for (size_t i = sizeof(T); i-- > 0;) {
+    data[i] = static_cast<unsigned char>(value & 0xff);
+    value = static_cast<T>(value >> 8);
+  }
+}
+
+BookEntry BookEntry::read(const unsigned char *data) {
+  return BookEntry{readBigEndian<uint64_t>(data), readBigEndian<uint16_t>(data + 8),
+                   readBigEndian<uint16_t>(data + 10), readBigEndian<uint32_t>(data + 12)};
+}
+
+void BookEntry::write(unsigned char *data) const {
+  writeBigEndian(data, key);
+  writeBigEndian(data + 8, move);
+  writeBigEndian(data + 10, weight);
+  writeBigEndian(data + 12, learn);
+}
+
+SoFUtil::Result<std::unique_ptr<Book>, IOError> Book::open(const std::string &path) {
+  SOF_TRY_DECL(file, SoFUtil::MappedFile::open(path));
+  if (file->size() % BookEntry::SIZE != 0) {
+    return SoFUtil::Err(IOError{"File \"" + path + "\" is not a valid opening book"});
+  }
+  return SoFUtil::Ok(std::unique_ptr<Book>(new Book(std::move(file))));
+}
+
+Move Book::pick(const Board &board, const Selection selection) const {
+  const uint64_t key = SoFCore::polyglotKey(board);
+
+  // Find the first entry with the given key
+  size_t left = 0;
+  size_t right = size_;
+  while (left < right) {
+    const size_t mid = left + (right - left) / 2;
+    if (entry(mid).key < key) {
+      left = mid + 1;
+    } else {
+      right = mid;
+    }
+  }
+
+  std::vector<std::pair<Move, uint16_t>> moves;
+  uint64_t totalWeight = 0;
+  for (size_t idx = left; idx < size_; ++idx) {
+    const BookEntry cur = entry(idx);
+    if (cur.key != key) {
+      break;
+    }
+    // Skip the moves that are illegal in this position, as the book may contain key collisions
+    const Move move = SoFCore::polyglotMoveDecode(board, cur.move);
+    if (cur.weight == 0 || move == Move::invalid()) {
+      continue;
+    }
+    moves.emplace_back(move, cur.weight);
+    totalWeight += cur.weight;
+  }
+  if (moves.empty()) {
+    return Move::null();
+  }
+
+  if (selection == Selection::Best) {
+    auto best = moves.begin();
+    for (auto iter = moves.begin(); iter != moves.end(); ++iter) {
+      if (iter->second > best->second) {
+        best = iter;
+      }
+    }
+    return best->first;
+  }
+  uint64_t value = SoFUtil::random() % totalWeight;
+  for (const auto &[move, weight] : moves) {
+    if (value < weight) {
+      return move;
+    }
+    value -= weight;
+  }
+  return moves.back().first;
+}
+
+}  // namespace SoFSearch::Private
@@ -0,0 +1,84 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef SOF_SEARCH_PRIVATE_BOOK_INCLUDED
+#define SOF_SEARCH_PRIVATE_BOOK_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "core/board.h"
+#include "core/move.h"
+#include "util/ioutil.h"
+#include "util/mapped_file.h"
+#include "util/no_copy_move.h"
+#include "util/result.h"
+
+namespace SoFSearch::Private {
+
+// Entry of the opening book in Polyglot format. In the file, the entries are sorted by key, and
+// each of them takes `SIZE` bytes, with all the fields stored in big-endian
+struct BookEntry {
+  uint64_t key;     // Key of the position, see `SoFCore::polyglotKey()`
+  uint16_t move;    // Move encoded with `SoFCore::polyglotMoveEncode()`
+  uint16_t weight;  // Move weight, the moves with zero weight are never played
+  uint32_t learn;   // Unused
+
+  static constexpr size_t SIZE = 16;
+
+  // Reads the entry from `SIZE` bytes starting from `data`
+  static BookEntry read(const unsigned char *data);
+
+  // Writes the entry into `SIZE` bytes starting from `data`
+  void write(unsigned char *data) const;
+};
+
+// Opening book in Polyglot format. The book file is memory-mapped, and the positions are found by
+// binary search
+class Book : public SoFUtil::NoCopyMove {
+public:
+  // Strategy to pick a move if there are multiple moves for the position in the book
+  enum class Selection {
+    Weighted,  // Random move with probability proportional to its weight
+    Best,      // Move with the highest weight
+  };
+
+  // Opens the book from the file `path`
+  static SoFUtil::Result<std::unique_ptr<Book>, SoFUtil::IOError> open(const std::string &path);
+
+  // Returns the book move for the position `board`, or `Move::null()` if the position is not in
+  // the book
+  SoFCore::Move pick(const SoFCore::Board &board, Selection selection) const;
+
+private:
+  explicit Book(std::unique_ptr<SoFUtil::MappedFile> file)
+      : file_(std::move(file)), size_(file_->size() / BookEntry::SIZE) {}
+
+  inline BookEntry entry(const size_t idx) const {
+    return BookEntry::read(file_->data() + idx * BookEntry::SIZE);
+  }
+
+  std::unique_ptr<SoFUtil::MappedFile> file_;
+  size_t size_;  // Number of entries
+};
+
+}  // namespace SoFSearch::Private
+
+#endif  // SOF_SEARCH_PRIVATE_BOOK_INCLUDED
@@ -18,6 +18,8 @@
 #ifndef SOF_SEARCH_PRIVATE_CONSTS_INCLUDED
 #define SOF_SEARCH_PRIVATE_CONSTS_INCLUDED
 
+#include <cstdint>
+
 #include "eval/score.h"
 
 namespace SoFSearch::Private {
@@ -56,6 +58,19 @@ constexpr int32_t MAX_DEPTH = 4;
 constexpr SoFEval::score_t MARGINS[MAX_DEPTH + 1] = {0, 100, 200, 300, 400};
 }  // namespace Razoring
 
+// Constants for tuning ProbCut
+namespace ProbCut {
+// Minimum depth to activate ProbCut
+constexpr int32_t MIN_DEPTH = 5;
+// Depth decrement for the reduced search of captures
+constexpr int32_t DEPTH_DEC = 4;
+// Margin added to beta. If a capture holds against the raised beta in the reduced search, we assume
+// that the full-depth search will also produce a beta cutoff
+constexpr SoFEval::score_t MARGIN = 200;
+
+static_assert(MIN_DEPTH > DEPTH_DEC, "We must not reach depth <= 0 in the reduced search");
+}  // namespace ProbCut
+
 // Constants for tuning late move reduction
 namespace LateMove {
 // Minimum depth to activate
@@ -66,6 +81,77 @@ constexpr int32_t REDUCE_DEPTH = 1;
 constexpr int32_t MOVES_NO_REDUCE = 2;
 }  // namespace LateMove
 
+// Constants for tuning internal iterative deepening (IID). It is applied in PV nodes without hash
+// move to find a good move to try first
+namespace InternalDeepening {
+// Minimum depth to activate
+constexpr int32_t MIN_DEPTH = 5;
+// Depth decrement for the internal search
+constexpr int32_t DEPTH_DEC = 2;
+
+static_assert(MIN_DEPTH > DEPTH_DEC, "We must not reach depth <= 0 in the internal search");
+}  // namespace InternalDeepening
+
+// Constants for tuning internal iterative reduction (IIR). It is applied in non-PV nodes without
+// hash move, as the move ordering there is likely to be poor
+namespace InternalReduction {
+// Minimum depth to activate
+constexpr int32_t MIN_DEPTH = 4;
+// Depth reduction amount
+constexpr int32_t REDUCE_DEPTH = 1;
+
+static_assert(MIN_DEPTH > REDUCE_DEPTH, "We must not reach depth <= 0 after reduction");
+}  // namespace InternalReduction
+
+// Constants for tuning quiescense search
+namespace Quiescense {
+// Safety margin for delta pruning. The capture is pruned if the static evaluation plus the cost of
+// the captured piece plus this margin still doesn't exceed alpha
+constexpr SoFEval::score_t DELTA_MARGIN = 200;
+// The capture of a defended piece is considered bad if the capturing piece is more expensive than
+// the captured one by more than this margin. Such captures are not searched
+constexpr SoFEval::score_t BAD_CAPTURE_MARGIN = 50;
+// Maximum depth of quiescense search. The nodes on this depth return the static evaluation without
+// searching any captures
+constexpr size_t MAX_DEPTH = 16;
+// Maximum number of nodes in one quiescense search tree, i.e. started from a single leaf of the
+// main search. When the budget is exhausted, the remaining nodes return the static evaluation.
+// Normally the trees are much smaller, but in pathological positions with many pieces attacking
+// each other (e.g. 15 rooks per side) the tree may grow exponentially and hang the engine
+constexpr size_t NODE_BUDGET = 256;
+}  // namespace Quiescense
+
+// Constants for early termination of the search when the best move is obvious
+namespace EasyMove {
+// Minimum number of consecutive iterations on which the best move must stay the same
+constexpr size_t MIN_STABLE_ITERATIONS = 8;
+// Minimum percentage of root nodes which must be spent on the best move. If other moves are
+// refuted quickly, then the best move is clearly superior
+constexpr uint64_t MIN_NODES_PERCENT = 90;
+// Minimum percentage of the allotted time which must pass before we stop the search
+constexpr int64_t MIN_TIME_PERCENT = 20;
+}  // namespace EasyMove
+
+// Constants for tuning history heuristics
+namespace History {
+// Multiplier for `depth * depth` to obtain a history bonus
+constexpr int32_t BONUS_MUL = 16;
+// Maximum history bonus (or malus) applied on a single update
+constexpr int32_t MAX_BONUS = 2048;
+// Maximum number of quiet moves in one node which will get a malus after a beta cutoff
+constexpr size_t MAX_MALUS_MOVES = 64;
+}  // namespace History
+
+// Constants for deterministic search mode
+namespace Deterministic {
+// Number of nodes which the job searches before passing the turn to the next job
+constexpr uint64_t QUANTUM_NODES = 4096;
+// Seed for the random number generators used by the jobs. Job `i` uses `SEED + i`
+constexpr uint64_t SEED = 0x50f'c4ec'0de7'e2a1;
+// Number of nodes per millisecond which is used to convert the time limit into the node limit
+constexpr uint64_t NODES_PER_MS = 1000;
+}  // namespace Deterministic
+
 }  // namespace SoFSearch::Private
 
 #endif  // SOF_SEARCH_PRIVATE_CONSTS_INCLUDED
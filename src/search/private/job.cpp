@@ -19,32 +19,44 @@
 
 #include <algorithm>
 #include <chrono>
+#include <random>
 #include <utility>
 #include <vector>
 
+#include "core/bitboard.h"
 #include "core/board.h"
 #include "core/move.h"
 #include "core/movegen.h"
 #include "core/strutil.h"
 #include "eval/evaluate.h"
+#include "eval/kpk.h"
 #include "search/private/consts.h"
 #include "search/private/diagnostics.h"
 #include "search/private/move_picker.h"
+#include "search/private/trace.h"
 #include "search/private/transposition_table.h"
 #include "search/private/types.h"
 #include "search/private/util.h"
+#include "util/defer.h"
 #include "util/misc.h"
 #include "util/no_copy_move.h"
 #include "util/operators.h"
 #include "util/random.h"
+#include "util/smallvec.h"
 
 namespace SoFSearch::Private {
 
 using SoFBotApi::PositionCostBound;
+using SoFCore::bitboard_t;
 using SoFCore::Board;
+using SoFCore::board_hash_t;
+using SoFCore::cell_t;
 using SoFCore::Move;
+using SoFCore::MoveKind;
 using SoFCore::MovePersistence;
 using SoFEval::adjustCheckmate;
+using SoFEval::KpkResult;
+using SoFEval::probeKpk;
 using SoFEval::SCORE_CHECKMATE_THRESHOLD;
 using SoFEval::SCORE_INF;
 using SoFEval::score_t;
@@ -70,22 +82,74 @@ void JobCommunicator::stop() {
   lock_.lock();
   lock_.unlock();
   event_.notify_all();
+  turnEvent_.notify_all();
 }
 
-void JobCommunicator::addLine(SoFBotApi::SearchResult line) {
+size_t JobCommunicator::updateBestMove(const Move move) {
+  std::unique_lock guard(lock_);
+  if (move != bestMove_) {
+    bestMove_ = move;
+    bestMoveStability_ = 0;
+  }
+  return ++bestMoveStability_;
+}
+
+void JobCommunicator::addLine(JobLine line) {
   std::unique_lock guard(lock_);
   lines_.push_back(std::move(line));
   guard.unlock();
   event_.notify_all();
 }
 
-std::vector<SoFBotApi::SearchResult> JobCommunicator::extractLines() {
+std::vector<JobLine> JobCommunicator::extractLines() {
   std::unique_lock guard(lock_);
   auto result = std::move(lines_);
   lines_.clear();
   return result;
 }
 
+void JobCommunicator::waitTurn(const size_t jobId) {
+  std::unique_lock guard(lock_);
+  turnEvent_.wait(guard, [&]() { return turn_ == jobId || isStopped(); });
+}
+
+void JobCommunicator::passTurn(const size_t jobId, const uint64_t nodes) {
+  std::unique_lock guard(lock_);
+  turnNodes_ += nodes;
+  if (turnNodes_ >= limits_.nodes) {
+    guard.unlock();
+    stop();
+    return;
+  }
+  turn_ = nextTurnUnlocked(jobId);
+  if (turn_ == jobId) {
+    return;
+  }
+  turnEvent_.notify_all();
+  turnEvent_.wait(guard, [&]() { return turn_ == jobId || isStopped(); });
+}
+
+void JobCommunicator::leaveTurns(const size_t jobId) {
+  std::unique_lock guard(lock_);
+  turnActive_[jobId] = false;
+  if (turn_ == jobId) {
+    turn_ = nextTurnUnlocked(jobId);
+  }
+  guard.unlock();
+  turnEvent_.notify_all();
+}
+
+size_t JobCommunicator::nextTurnUnlocked(const size_t jobId) const {
+  const size_t count = turnActive_.size();
+  for (size_t i = 1; i <= count; ++i) {
+    const size_t next = (jobId + i) % count;
+    if (turnActive_[next]) {
+      return next;
+    }
+  }
+  return jobId;
+}
+
 JobCommunicator::Event JobCommunicator::checkEventUnlocked() {
   if (!lines_.empty()) {
     return Event::NewLines;
@@ -169,16 +233,51 @@ public:
     NullMoveDisable = NullMove | NullMoveReduction | Capture
   };
 
-  inline Searcher(Job &job, Board &board, RepetitionTable &repetitions)
+  // Creates the searcher for the position `board`. `history` contains the hashes of the positions
+  // that occurred in the game before `board`, in chronological order. Only the positions after the
+  // last irreversible move are required
+  inline Searcher(Job &job, Board &board, const std::vector<board_hash_t> &history)
       : board_(board),
         tt_(job.tt_),
         comm_(job.comm_),
         stats_(job.stats_),
         evaluator_(job.evaluator_),
-        repetitions_(repetitions),
-        jobId_(job.id_) {}
+        history_(job.history_),
+        hashes_(history.size() + MAX_STACK_DEPTH),
+        historySize_(history.size()),
+        jobId_(job.id_),
+        deterministic_(job.comm_.limits().deterministic),
+        random_(deterministic_ ? Deterministic::SEED + job.id_ : SoFUtil::random()),
+        turnStartNodes_(job.stats_.get(JobStat::Nodes)),
+        turnEndNodes_(turnStartNodes_ + Deterministic::QUANTUM_NODES)
+            TRACE(, tracer_(job.traceSink_, job.id_)) {
+    for (const SoFCore::Color color : {SoFCore::Color::White, SoFCore::Color::Black}) {
+      for (int8_t piece = 0; piece < 6; ++piece) {
+        const auto p = static_cast<SoFCore::Piece>(piece);
+        cellCosts_[makeCell(color, p)] = Evaluator::pieceCost(p);
+      }
+    }
+    std::copy(history.begin(), history.end(), hashes_.begin());
+  }
+
+  // Returns the list of moves in the root node, together with their statistics collected on the
+  // current iteration
+  inline const RootMoveList &rootMoves() const { return rootMoves_; }
+
+  // Passes the turn to the next job in deterministic mode
+  void passTurn() const {
+    const uint64_t nodes = stats_.get(JobStat::Nodes);
+    comm_.passTurn(jobId_, nodes - turnStartNodes_);
+    turnStartNodes_ = nodes;
+    turnEndNodes_ = nodes + Deterministic::QUANTUM_NODES;
+  }
 
   inline score_t run(const size_t depth, Move &bestMove) {
+    if (depth_ == 0) {
+      initRootMoves();
+    } else {
+      rootMoves_.reorder(stack_[0].bestMove);
+    }
     depth_ = depth;
     const score_t score =
         search<NodeKind::Root>(static_cast<int32_t>(depth), 0, -SCORE_INF, SCORE_INF,
@@ -198,10 +297,31 @@ private:
     return kind == NodeKind::Root || kind == NodeKind::Pv;
   }
 
+  // Fills the list of root moves. Initially, the moves are sorted in the same order as returned by
+  // `MovePicker`
+  void initRootMoves() {
+    const Move hashMove = tt_.load(board_.hash).move();
+    MovePicker picker(board_, hashMove, stack_[0].killers, history_);
+    for (Move move = picker.next(); move != Move::invalid(); move = picker.next()) {
+      if (move == Move::null()) {
+        continue;
+      }
+      if (isMoveLegal(board_, move)) {
+        rootMoves_.add(move);
+      }
+    }
+  }
+
   inline bool mustStop() const {
     if (comm_.isStopped()) {
       return true;
     }
+    if (deterministic_) {
+      if (stats_.get(JobStat::Nodes) >= turnEndNodes_) {
+        passTurn();
+      }
+      return comm_.isStopped() || comm_.depth() != depth_;
+    }
     ++counter_;
     if (!(counter_ & 1023)) {
       return comm_.checkTimeout();
@@ -213,35 +333,104 @@ private:
   inline score_t search(const int32_t depth, const size_t idepth, const score_t alpha,
                         const score_t beta, const Evaluator::Tag tag, const Flags flags) {
     tt_.prefetch(board_.hash);
-    if (!repetitions_.insert(board_.hash)) {
-      return 0;
+    if constexpr (Node != NodeKind::Root) {
+      if (isRepetition(idepth)) {
+        TRACE(trace(TraceEventKind::Prune, TracePrune::Repetition, idepth, depth, alpha, beta);)
+        return 0;
+      }
     }
-    DIAGNOSTIC(const SoFCore::board_hash_t savedHash = board_.hash);
+    hashes_[historySize_ + idepth] = board_.hash;
+    DIAGNOSTIC(const board_hash_t savedHash = board_.hash);
+    TRACE(trace(TraceEventKind::Enter, 0, idepth, depth, alpha, beta);)
     const score_t score = doSearch<Node>(depth, idepth, alpha, beta, tag, flags);
+    TRACE(trace(TraceEventKind::Exit, 0, idepth, depth, alpha, beta, score);)
     DGN_ASSERT(score <= alpha || score >= beta ||
                isScoreValid(adjustCheckmate(score, -static_cast<int16_t>(idepth))));
     DGN_ASSERT(board_.hash == savedHash);
-    repetitions_.erase(board_.hash);
     return score;
   }
 
+  // Runs quiescense search. `qdepth` is the number of plies from the start of quiescense search
+  inline score_t quiescenseSearch(const score_t alpha, const score_t beta,
+                                  const Evaluator::Tag tag, const size_t qdepth = 0) {
+    TRACE(trace(TraceEventKind::QEnter, 0, 0, -static_cast<int32_t>(qdepth), alpha, beta);)
+    if (qdepth == 0) {
+      quiescenseNodesLeft_ = Quiescense::NODE_BUDGET;
+    }
+    const score_t score = doQuiescenseSearch(alpha, beta, tag, qdepth);
+    TRACE(trace(TraceEventKind::QExit, 0, 0, -static_cast<int32_t>(qdepth), alpha, beta, score);)
+    return score;
+  }
+
+#ifdef USE_SEARCH_TRACE
+  // Adds an event into the search trace
+  template <typename Arg>
+  inline void trace(const TraceEventKind kind, const Arg arg, const size_t idepth,
+                    const int32_t depth, const score_t alpha, const score_t beta,
+                    const score_t score = 0, const size_t index = 0) {
+    tracer_.add(TraceEvent{kind, static_cast<uint8_t>(arg), static_cast<uint16_t>(idepth),
+                           static_cast<int16_t>(depth), alpha, beta, score,
+                           static_cast<uint32_t>(index)});
+  }
+#endif
+
+  // Returns `true` if the current position on depth `idepth` must be considered as a draw by
+  // repetition
+  inline bool isRepetition(const size_t idepth) const {
+    return Private::isRepetition(hashes_.data(), historySize_, historySize_ + idepth, board_);
+  }
+
+  // Returns the maximum material gain after making the move `move`. This doesn't take into account
+  // that the moving piece can be recaptured
+  inline score_t moveGain(const Move move) const {
+    const cell_t pawn = makeCell(board_.side, SoFCore::Piece::Pawn);
+    score_t gain =
+        (move.kind == MoveKind::Enpassant) ? cellCosts_[pawn] : cellCosts_[board_.cells[move.dst]];
+    if (isMoveKindPromote(move.kind)) {
+      gain += cellCosts_[makeCell(board_.side, moveKindPromotePiece(move.kind))] - cellCosts_[pawn];
+    }
+    return gain;
+  }
+
+  // Returns `true` if the capture `move` is likely to lose material, i.e. a much more valuable
+  // piece captures a less valuable one, and the captured piece is defended. This is a cheap
+  // replacement for static exchange evaluation
+  inline bool isBadCapture(const Move move) const {
+    if (move.kind != MoveKind::Simple) {
+      return false;
+    }
+    const cell_t src = board_.cells[move.src];
+    const cell_t dst = board_.cells[move.dst];
+    return cellCosts_[src] - cellCosts_[dst] > Quiescense::BAD_CAPTURE_MARGIN &&
+           isCellAttacked(board_, move.dst, SoFCore::invert(board_.side));
+  }
+
   template <NodeKind Node>
   score_t doSearch(int32_t depth, size_t idepth, score_t alpha, score_t beta, Evaluator::Tag tag,
                    Flags flags);
 
-  score_t quiescenseSearch(score_t alpha, score_t beta, Evaluator::Tag tag);
+  score_t doQuiescenseSearch(score_t alpha, score_t beta, Evaluator::Tag tag, size_t qdepth);
 
   Board &board_;
   TranspositionTable &tt_;
   JobCommunicator &comm_;
   JobStats &stats_;
   Evaluator &evaluator_;
-  RepetitionTable &repetitions_;
+  HistoryTable &history_;
+  std::vector<board_hash_t> hashes_;  // Stack of position hashes, prepended with game history
+  size_t historySize_;
   size_t jobId_;
+  bool deterministic_;
+  std::mt19937_64 random_;
+  mutable uint64_t turnStartNodes_;
+  mutable uint64_t turnEndNodes_;
+  TRACE(Tracer tracer_;)
 
   Frame stack_[MAX_STACK_DEPTH];
-  HistoryTable history_;
+  RootMoveList rootMoves_;
+  score_t cellCosts_[16] = {};
   size_t depth_ = 0;
+  size_t quiescenseNodesLeft_ = 0;
   mutable size_t counter_ = 0;
 };
 
@@ -250,12 +439,10 @@ SOF_ENUM_EQUAL(Searcher::Flags, uint64_t)
 
 class RootNodeMovePicker {
 public:
-  RootNodeMovePicker(MovePicker picker, const size_t jobId) {
-    for (Move move = picker.next(); move != Move::invalid(); move = picker.next()) {
-      if (move == Move::null()) {
-        continue;
-      }
-      moves_[moveCount_++] = move;
+  RootNodeMovePicker(const RootMoveList &rootMoves, const size_t jobId,
+                     std::mt19937_64 &random) {
+    for (const RootMoveList::Item &item : rootMoves) {
+      moves_[moveCount_++] = item.move;
     }
     if (jobId == 0) {
       return;
@@ -263,7 +450,7 @@ public:
     if (jobId < moveCount_) {
       std::reverse(moves_, moves_ + jobId + 1);
     } else {
-      SoFUtil::randomShuffle(moves_, moves_ + moveCount_);
+      std::shuffle(moves_, moves_ + moveCount_, random);
     }
   }
 
@@ -283,7 +470,9 @@ private:
 template <Searcher::NodeKind Kind>
 struct MovePickerFactory {
   template <typename... Args>
-  inline static MovePicker create([[maybe_unused]] const size_t jobId, Args &&...args) {
+  inline static MovePicker create([[maybe_unused]] const RootMoveList &rootMoves,
+                                  [[maybe_unused]] const size_t jobId,
+                                  [[maybe_unused]] std::mt19937_64 &random, Args &&...args) {
     return MovePicker(std::forward<Args>(args)...);
   }
 };
@@ -291,8 +480,9 @@ struct MovePickerFactory {
 template <>
 struct MovePickerFactory<Searcher::NodeKind::Root> {
   template <typename... Args>
-  inline static RootNodeMovePicker create(const size_t jobId, Args &&...args) {
-    return RootNodeMovePicker(MovePicker(std::forward<Args>(args)...), jobId);
+  inline static RootNodeMovePicker create(const RootMoveList &rootMoves, const size_t jobId,
+                                          std::mt19937_64 &random, Args &&...) {
+    return RootNodeMovePicker(rootMoves, jobId, random);
   }
 };
 
@@ -315,12 +505,14 @@ private:
 };
 #endif
 
-score_t Searcher::quiescenseSearch(score_t alpha, const score_t beta, const Evaluator::Tag tag) {
-  if (isBoardDrawInsufficientMaterial(board_)) {
+score_t Searcher::doQuiescenseSearch(score_t alpha, const score_t beta, const Evaluator::Tag tag,
+                                     const size_t qdepth) {
+  if (isBoardDrawInsufficientMaterial(board_) || probeKpk(board_) == KpkResult::Draw) {
     return 0;
   }
 
   stats_.inc(JobStat::Nodes);
+  stats_.inc(JobStat::QuiescenseNodes);
 
   const score_t evalScore = evaluator_.evalForCur(board_, tag);
   DIAGNOSTIC({
@@ -333,6 +525,28 @@ score_t Searcher::quiescenseSearch(score_t alpha, const score_t beta, const Eval
   if (alpha >= beta) {
     return beta;
   }
+  if (qdepth >= Quiescense::MAX_DEPTH || quiescenseNodesLeft_ == 0) {
+    return alpha;
+  }
+  --quiescenseNodesLeft_;
+
+  // Delta pruning. First, check whether even the best possible capture can improve alpha. If it
+  // cannot, then there is no reason to search further
+  const bool isInCheck = isCheck(board_);
+  if (!isInCheck) {
+    const cell_t queen = makeCell(board_.side, SoFCore::Piece::Queen);
+    const cell_t pawn = makeCell(board_.side, SoFCore::Piece::Pawn);
+    const bitboard_t bbPromoteRow = SoFCore::BB_ROW[board_.side == SoFCore::Color::White ? 1 : 6];
+    int32_t maxGain = cellCosts_[queen];
+    if (board_.bbPieces[pawn] & bbPromoteRow) {
+      maxGain += cellCosts_[queen] - cellCosts_[pawn];
+    }
+    if (evalScore + maxGain + Quiescense::DELTA_MARGIN <= alpha) {
+      TRACE(trace(TraceEventKind::Prune, TracePrune::Delta, 0, -static_cast<int32_t>(qdepth), alpha,
+                  beta);)
+      return alpha;
+    }
+  }
 
   DIAGNOSTIC(DgnMoveRepeatChecker dgnMoves;)
   QuiescenseMovePicker picker(board_);
@@ -341,11 +555,21 @@ score_t Searcher::quiescenseSearch(score_t alpha, const score_t beta, const Eval
       continue;
     }
     DIAGNOSTIC(dgnMoves.add(move);)
+    if (!isInCheck) {
+      // Delta pruning for a single move: skip the moves which cannot improve alpha
+      if (static_cast<int32_t>(evalScore) + moveGain(move) + Quiescense::DELTA_MARGIN <= alpha) {
+        continue;
+      }
+      // Do not consider the captures which are likely to lose material
+      if (isBadCapture(move)) {
+        continue;
+      }
+    }
     MoveMakeGuard guard(board_, move, tag);
     if (!wasMoveLegal(board_)) {
       continue;
     }
-    const score_t score = -quiescenseSearch(-beta, -alpha, guard.tag());
+    const score_t score = -quiescenseSearch(-beta, -alpha, guard.tag(), qdepth + 1);
     DIAGNOSTIC({
       if (alpha < score && score < beta) {
         DGN_ASSERT(isScoreValid(score));
@@ -377,10 +601,9 @@ score_t Searcher::doSearch(int32_t depth, const size_t idepth, score_t alpha, co
 
   // Check for draw
   if constexpr (Node != NodeKind::Root) {
-    if (board_.moveCounter >= 100) {
-      return 0;
-    }
-    if (isBoardDrawInsufficientMaterial(board_)) {
+    if (board_.moveCounter >= 100 || isBoardDrawInsufficientMaterial(board_) ||
+        probeKpk(board_) == KpkResult::Draw) {
+      TRACE(trace(TraceEventKind::Prune, TracePrune::Draw, idepth, depth, alpha, beta);)
       return 0;
     }
   }
@@ -423,13 +646,16 @@ score_t Searcher::doSearch(int32_t depth, const size_t idepth, score_t alpha, co
 
   // Probe the transposition table
   Move hashMove = Move::null();
+  TRACE(TraceTt ttResult = TraceTt::Miss;)
   if (const TranspositionTable::Data data = tt_.load(board_.hash); data.isValid()) {
     stats_.inc(JobStat::TtHits);
+    TRACE(ttResult = TraceTt::Hit;)
     hashMove = data.move();
     const bool allowCutoff = Node != NodeKind::Root && data.depth() >= depth &&
                              board_.moveCounter < 90 &&
                              (!isNodeKindPv(Node) || tt_.isCurrentEpoch(data));
     if (allowCutoff) {
+      stats_.inc(JobStat::TtCutoffTries, depth);
       const score_t score = adjustCheckmate(data.score(), static_cast<int16_t>(idepth));
       const PositionCostBound bound = data.bound();
       const bool isCutoff = bound == PositionCostBound::Exact ||
@@ -437,11 +663,13 @@ score_t Searcher::doSearch(int32_t depth, const size_t idepth, score_t alpha, co
                             (bound == PositionCostBound::Upperbound && alpha >= score);
       if (isCutoff) {
         frame.bestMove = hashMove;
-        stats_.inc(JobStat::TtCutoffHits);
+        stats_.inc(JobStat::TtCutoffHits, depth);
+        TRACE(trace(TraceEventKind::Tt, TraceTt::Cutoff, idepth, depth, alpha, beta, score);)
         return score;
       }
     }
   }
+  TRACE(trace(TraceEventKind::Tt, ttResult, idepth, depth, alpha, beta);)
 
   const bool isInCheck = isCheck(board_);
   const bool isMateBounds =
@@ -461,17 +689,23 @@ score_t Searcher::doSearch(int32_t depth, const size_t idepth, score_t alpha, co
   if (!isNodeKindPv(Node) && !isInCheck && !isMateBounds) {
     // Futility pruning
     if (depth <= Futility::MAX_DEPTH) {
+      stats_.inc(JobStat::FutilityTries, depth);
       const score_t threshold = beta + Futility::MARGINS[depth];
       if (getEvalScore() >= threshold) {
+        stats_.inc(JobStat::FutilityPrunes, depth);
+        TRACE(trace(TraceEventKind::Prune, TracePrune::Futility, idepth, depth, alpha, beta);)
         return beta;
       }
     }
 
     // Razoring
     if (depth <= Razoring::MAX_DEPTH) {
+      stats_.inc(JobStat::RazoringTries, depth);
       const score_t threshold = alpha - Razoring::MARGINS[depth];
       if (getEvalScore() <= threshold &&
           quiescenseSearch(threshold, threshold + 1, tag) <= threshold) {
+        stats_.inc(JobStat::RazoringPrunes, depth);
+        TRACE(trace(TraceEventKind::Prune, TracePrune::Razoring, idepth, depth, alpha, beta);)
         return alpha;
       }
     }
@@ -482,6 +716,7 @@ score_t Searcher::doSearch(int32_t depth, const size_t idepth, score_t alpha, co
   const bool canNullMove = !isNodeKindPv(Node) && depth >= NullMove::MIN_DEPTH && !isInCheck &&
                            !isMateBounds && (flags & Flags::NullMoveDisable) == Flags::None;
   if (canNullMove) {
+    stats_.inc(JobStat::NullMoveTries, depth);
     MoveMakeGuard guard(board_, Move::null(), tag);
     tt_.prefetch(board_.hash);
     DGN_ASSERT(wasMoveLegal(board_));
@@ -493,16 +728,77 @@ score_t Searcher::doSearch(int32_t depth, const size_t idepth, score_t alpha, co
     }
     guard.release();
     if (score >= beta) {
+      stats_.inc(JobStat::NullMoveReductions, depth);
       depth -= NullMove::REDUCTION_DEC;
       flags |= Flags::NullMoveReduction;
       DGN_ASSERT(depth > 0);
     }
   }
 
+  // ProbCut. If there is a good capture, which holds against the raised beta in the reduced search,
+  // then the full-depth search will most likely produce a beta cutoff, so we can prune the node
+  const score_t probCutBeta = beta + ProbCut::MARGIN;
+  const bool canProbCut = !isNodeKindPv(Node) && depth >= ProbCut::MIN_DEPTH && !isInCheck &&
+                          !isMateBounds && probCutBeta < SCORE_CHECKMATE_THRESHOLD;
+  if (canProbCut) {
+    stats_.inc(JobStat::ProbCutTries, depth);
+    QuiescenseMovePicker picker(board_);
+    for (Move move = picker.next(); move != Move::invalid(); move = picker.next()) {
+      if (move == Move::null() || isBadCapture(move) ||
+          getEvalScore() + moveGain(move) < probCutBeta) {
+        continue;
+      }
+      MoveMakeGuard guard(board_, move, tag);
+      tt_.prefetch(board_.hash);
+      if (!wasMoveLegal(board_)) {
+        continue;
+      }
+      // Verify the capture with quiescense search first, as it's much cheaper
+      score_t score = -quiescenseSearch(-probCutBeta, -probCutBeta + 1, guard.tag());
+      if (score >= probCutBeta) {
+        const Flags newFlags = (flags & Flags::Inherit) | Flags::Capture;
+        score = -search<NodeKind::Simple>(depth - ProbCut::DEPTH_DEC, idepth + 1, -probCutBeta,
+                                          -probCutBeta + 1, guard.tag(), newFlags);
+      }
+      if (mustStop()) {
+        return 0;
+      }
+      if (score >= probCutBeta) {
+        stats_.inc(JobStat::ProbCutPrunes, depth);
+        TRACE(trace(TraceEventKind::Prune, TracePrune::ProbCut, idepth, depth, alpha, beta);)
+        return beta;
+      }
+    }
+  }
+
+  // If there is no hash move, the move ordering is likely to be poor. In PV nodes, we run internal
+  // iterative deepening, i.e. search the same node with reduced depth to find a good first move.
+  // In non-PV nodes such search is too expensive, so we just reduce the depth
+  if (hashMove == Move::null()) {
+    if constexpr (Node == NodeKind::Pv) {
+      if (depth >= InternalDeepening::MIN_DEPTH) {
+        doSearch<Node>(depth - InternalDeepening::DEPTH_DEC, idepth, alpha, beta, tag, flags);
+        if (mustStop()) {
+          return 0;
+        }
+        hashMove = frame.bestMove;
+        frame.bestMove = Move::null();
+      }
+    }
+    if constexpr (!isNodeKindPv(Node)) {
+      if (depth >= InternalReduction::MIN_DEPTH) {
+        depth -= InternalReduction::REDUCE_DEPTH;
+      }
+    }
+  }
+
   // Iterate over the moves in the sorted order
-  auto picker = MovePickerFactory<Node>::create(jobId_, board_, hashMove, frame.killers, history_);
+  auto picker = MovePickerFactory<Node>::create(rootMoves_, jobId_, random_, board_, hashMove,
+                                                frame.killers, history_);
   bool hasMove = false;
   size_t numHistoryMoves = 0;
+  SoFUtil::SmallVector<Move, History::MAX_MALUS_MOVES> quietMoves;
+  size_t moveIndex = 0;
   DIAGNOSTIC(DgnMoveRepeatChecker dgnMoves;)
   stats_.inc(isNodeKindPv(Node) ? JobStat::PvInternalNodes : JobStat::NonPvInternalNodes);
   for (Move move = picker.next(); move != Move::invalid(); move = picker.next()) {
@@ -521,10 +817,19 @@ score_t Searcher::doSearch(int32_t depth, const size_t idepth, score_t alpha, co
       }
     }
 
+    if constexpr (Node != NodeKind::Root) {
+      if (picker.stage() >= MovePickerStage::Killer &&
+          quietMoves.size() < History::MAX_MALUS_MOVES) {
+        quietMoves.push_back(move);
+      }
+    }
+
     const bool isCapture = isMoveCapture(board_, move);
     const Flags newFlags = (flags & Flags::Inherit) | (isCapture ? Flags::Capture : Flags::None);
     const bool isFirstMove = !hasMove;
     hasMove = true;
+    ++moveIndex;
+    [[maybe_unused]] const uint64_t nodesBefore = stats_.get(JobStat::Nodes);
 
     // Late move reduction (LMR)
     if constexpr (Node != NodeKind::Root) {
@@ -532,6 +837,7 @@ score_t Searcher::doSearch(int32_t depth, const size_t idepth, score_t alpha, co
                               picker.stage() == MovePickerStage::History &&
                               numHistoryMoves > LateMove::MOVES_NO_REDUCE && !isCheck(board_);
       if (lmrEnabled) {
+        stats_.inc(JobStat::LmrTries, depth);
         const score_t score =
             -search<NodeKind::Simple>(depth - 1 - LateMove::REDUCE_DEPTH, idepth + 1, -alpha - 1,
                                       -alpha, guard.tag(), newFlags | Flags::LateMoveReduction);
@@ -541,6 +847,7 @@ score_t Searcher::doSearch(int32_t depth, const size_t idepth, score_t alpha, co
         if (score <= alpha) {
           continue;
         }
+        stats_.inc(JobStat::LmrResearches, depth);
       }
     }
 
@@ -550,6 +857,7 @@ score_t Searcher::doSearch(int32_t depth, const size_t idepth, score_t alpha, co
     const bool doZeroWindowSearch = isNodeKindPv(Node) && !isFirstMove;
     if (doZeroWindowSearch) {
       stats_.inc(JobStat::PNEdges);
+      stats_.inc(JobStat::PvsTries, depth);
       score = -search<NodeKind::Simple>(depth - 1, idepth + 1, -alpha - 1, -alpha, guard.tag(),
                                         newFlags);
       score = score <= alpha ? alpha : alpha + 1;
@@ -558,6 +866,9 @@ score_t Searcher::doSearch(int32_t depth, const size_t idepth, score_t alpha, co
       }
     }
     if (!doZeroWindowSearch || (alpha < score && (Node == NodeKind::Root || score < beta))) {
+      if (doZeroWindowSearch) {
+        stats_.inc(JobStat::PvsResearches, depth);
+      }
       constexpr NodeKind newNode = isNodeKindPv(Node) ? NodeKind::Pv : NodeKind::Simple;
       stats_.inc(isNodeKindPv(Node) ? JobStat::PPEdges : JobStat::NNEdges);
       score = -search<newNode>(depth - 1, idepth + 1, -beta, -alpha, guard.tag(), newFlags);
@@ -567,16 +878,31 @@ score_t Searcher::doSearch(int32_t depth, const size_t idepth, score_t alpha, co
     }
     guard.release();
 
+    if constexpr (Node == NodeKind::Root) {
+      RootMoveList::Item *item = rootMoves_.find(move);
+      DGN_ASSERT(item != nullptr);
+      item->nodes += stats_.get(JobStat::Nodes) - nodesBefore;
+      item->score = (score > alpha) ? score : -SCORE_INF;
+    }
+
     if (score > alpha) {
       alpha = score;
       frame.bestMove = move;
     }
     if (alpha >= beta) {
       if constexpr (Node != NodeKind::Root) {
+        stats_.addCutoff(picker.stage(), moveIndex - 1);
+        TRACE(trace(TraceEventKind::Cutoff, picker.stage(), idepth, depth, origAlpha, beta, beta,
+                    moveIndex - 1);)
         if (picker.stage() >= MovePickerStage::Killer) {
           frame.killers.add(move);
-          // NOLINTNEXTLINE(bugprone-implicit-widening-of-multiplication-result)
-          history_[move] += depth * depth;
+          const int32_t bonus = HistoryTable::bonus(depth);
+          history_.update(move, bonus);
+          for (const Move quietMove : quietMoves) {
+            if (quietMove != move) {
+              history_.update(quietMove, -bonus);
+            }
+          }
         }
       }
       ttStore(beta);
@@ -616,20 +942,48 @@ std::vector<Move> unwindPv(Board board, const Move bestMove, TranspositionTable
   return pv;
 }
 
-void Job::run(const Position &position) {
-  // Apply moves and fill repetition tables
-  Board board = position.first;
-  RepetitionTable singleRepeat;
-  RepetitionTable doubleRepeat;
-  for (const Move move : position.moves) {
-    if (!singleRepeat.insert(board.hash)) {
-      doubleRepeat.insert(board.hash);
+// Returns `true` if the best move `bestMove` is clearly superior to the others, so the search may
+// be stopped early. `stableIterations` is the number of consecutive iterations on which the best
+// move stayed the same
+static bool isEasyMove(const JobCommunicator &comm, const RootMoveList &rootMoves,
+                       const Move bestMove, const size_t stableIterations) {
+  const SearchLimits &limits = comm.limits();
+  if (!limits.canStopEarly || limits.time == TIME_UNLIMITED ||
+      stableIterations < EasyMove::MIN_STABLE_ITERATIONS) {
+    return false;
+  }
+  const auto timePassed = std::chrono::steady_clock::now() - comm.startTime();
+  if (timePassed * 100 < limits.time * EasyMove::MIN_TIME_PERCENT) {
+    return false;
+  }
+  uint64_t totalNodes = 0;
+  uint64_t bestNodes = 0;
+  for (const RootMoveList::Item &item : rootMoves) {
+    totalNodes += item.nodes;
+    if (item.move == bestMove) {
+      bestNodes = item.nodes;
     }
-    moveMake(board, move);
   }
+  return bestNodes * 100 >= totalNodes * EasyMove::MIN_NODES_PERCENT;
+}
+
+void Job::run(const GameState &game) {
+  const bool deterministic = comm_.limits().deterministic;
+  if (deterministic) {
+    comm_.waitTurn(id_);
+  }
+  SOF_DEFER({
+    if (deterministic) {
+      comm_.leaveTurns(id_);
+    }
+  });
+
+  // The history is kept from the previous searches, so age it to let the fresh values dominate
+  history_.age();
 
   // Perform iterative deepening
-  Searcher searcher(*this, board, doubleRepeat);
+  Board board = game.board();
+  Searcher searcher(*this, board, game.history());
   const size_t maxDepth = std::min(comm_.limits().depth, MAX_DEPTH);
   for (size_t depth = 1; depth <= maxDepth; ++depth) {
     Move bestMove = Move::null();
@@ -641,8 +995,16 @@ void Job::run(const Position &position) {
       DGN_ASSERT(bestMove != Move::null());
       std::vector<Move> pv = unwindPv(board, bestMove, tt_);
       DGN_ASSERT(!pv.empty());
-      comm_.addLine(
-          {depth, std::move(pv), SoFEval::scoreToPositionCost(score), PositionCostBound::Exact});
+      SoFBotApi::SearchResult result{depth, std::move(pv), SoFEval::scoreToPositionCost(score),
+                                     PositionCostBound::Exact};
+      comm_.addLine({std::move(result), id_, std::chrono::steady_clock::now(), stats_.snapshot()});
+
+      // Do not waste time if there is only one legal move or the best move is obvious
+      const bool isForcedMove = searcher.rootMoves().size() == 1 && comm_.limits().canStopEarly;
+      const size_t stableIterations = comm_.updateBestMove(bestMove);
+      if (isForcedMove || isEasyMove(comm_, searcher.rootMoves(), bestMove, stableIterations)) {
+        break;
+      }
     }
   }
 
@@ -18,6 +18,8 @@
 #ifndef SOF_SEARCH_PRIVATE_JOB_INCLUDED
 #define SOF_SEARCH_PRIVATE_JOB_INCLUDED
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
@@ -27,13 +29,143 @@
 #include <vector>
 
 #include "bot_api/types.h"
+#include "core/move.h"
 #include "eval/score.h"
 #include "search/private/limits.h"
+#include "search/private/move_picker.h"
+#include "search/private/trace.h"
+#include "search/private/util.h"
 
 namespace SoFSearch::Private {
 
 class TranspositionTable;
-struct Position;
+class GameState;
+
+// Type of job stats
+enum class JobStat : size_t {
+  Nodes,
+  QuiescenseNodes,
+  TtHits,
+  TtCutoffHits,
+  PvNodes,
+  NonPvNodes,
+  PvInternalNodes,
+  NonPvInternalNodes,
+  PPEdges,  // PV -> PV transitions
+  PNEdges,  // PV -> non-PV transitions
+  NNEdges,  // non-PV -> non-PV transitions
+
+  // Pruning statistics. For each technique, there is a number of attempts to apply it and a number
+  // of successes. They are also collected per depth
+  FutilityTries,
+  FutilityPrunes,
+  RazoringTries,
+  RazoringPrunes,
+  NullMoveTries,
+  NullMoveReductions,
+  ProbCutTries,
+  ProbCutPrunes,
+  LmrTries,
+  LmrResearches,  // LMR failed, and the move was searched again with full depth
+  PvsTries,
+  PvsResearches,  // Zero window search failed high, and the move was searched with full window
+  TtCutoffTries,
+
+  // Move ordering statistics
+  BetaCutoffs,
+  FirstMoveCutoffs,  // Beta cutoffs produced by the first legal move
+
+  Max  // Fake type to denote the total number of stats
+};
+
+// Number of job stats
+constexpr size_t JOB_STAT_SZ = static_cast<size_t>(JobStat::Max);
+
+// Number of depths for which the stats are collected separately. All the depths greater than or
+// equal to `JOB_STAT_DEPTH_SZ - 1` fall into the last bucket
+constexpr size_t JOB_STAT_DEPTH_SZ = 16;
+
+// Number of move indices for which the beta cutoffs are counted separately. All the indices greater
+// than or equal to `JOB_CUTOFF_INDEX_SZ - 1` fall into the last bucket
+constexpr size_t JOB_CUTOFF_INDEX_SZ = 16;
+
+// Values of all the job statistics
+using JobStatsSnapshot = std::array<uint64_t, JOB_STAT_SZ>;
+
+// Job statistics. This class is thread-safe if there is no more than one writer thread. If two
+// threads write concurrently, a race condition occurs.
+class JobStats {
+public:
+  // Returns job statistic `stat`. Can be called by reader threads.
+  inline uint64_t get(const JobStat stat) const {
+    return stats_[static_cast<size_t>(stat)].load(std::memory_order_relaxed);
+  }
+
+  // Returns the values of all the job statistics. Can be called by reader threads.
+  inline JobStatsSnapshot snapshot() const {
+    JobStatsSnapshot result;
+    for (size_t i = 0; i < JOB_STAT_SZ; ++i) {
+      result[i] = stats_[i].load(std::memory_order_relaxed);
+    }
+    return result;
+  }
+
+  // Returns how many times job statistic `stat` was incremented on depth bucket `depth`. Can be
+  // called by reader threads.
+  inline uint64_t getDepth(const JobStat stat, const size_t depth) const {
+    return depthStats_[static_cast<size_t>(stat)][depth].load(std::memory_order_relaxed);
+  }
+
+  // Returns how many beta cutoffs occurred on the move with index bucket `index` returned by the
+  // move picker on stage `stage`. Can be called by reader threads.
+  inline uint64_t getCutoff(const MovePickerStage stage, const size_t index) const {
+    return cutoffs_[static_cast<size_t>(stage)][index].load(std::memory_order_relaxed);
+  }
+
+  // Increments job statistic `stat`. Can be called by a single writer thread.
+  inline void inc(const JobStat stat) { incValue(stats_[static_cast<size_t>(stat)]); }
+
+  // Records that a beta cutoff occurred on the move with index `index` (zero-based, counting only
+  // legal moves), which was returned by the move picker on stage `stage`. Can be called by a single
+  // writer thread.
+  inline void addCutoff(const MovePickerStage stage, const size_t index) {
+    inc(JobStat::BetaCutoffs);
+    if (index == 0) {
+      inc(JobStat::FirstMoveCutoffs);
+    }
+    incValue(cutoffs_[static_cast<size_t>(stage)][std::min(index, JOB_CUTOFF_INDEX_SZ - 1)]);
+  }
+
+  // Increments job statistic `stat` and records that it happened on depth `depth`. Can be called by
+  // a single writer thread.
+  inline void inc(const JobStat stat, const int32_t depth) {
+    inc(stat);
+    const auto bucket = static_cast<size_t>(
+        std::clamp<int32_t>(depth, 0, static_cast<int32_t>(JOB_STAT_DEPTH_SZ) - 1));
+    incValue(depthStats_[static_cast<size_t>(stat)][bucket]);
+  }
+
+private:
+  inline static void incValue(std::atomic<uint64_t> &value) {
+    const uint64_t newValue = value.load(std::memory_order_relaxed) + 1;
+    value.store(newValue, std::memory_order_relaxed);
+  }
+
+  std::atomic<uint64_t> stats_[JOB_STAT_SZ] = {};
+  std::atomic<uint64_t> depthStats_[JOB_STAT_SZ][JOB_STAT_DEPTH_SZ] = {};
+  std::atomic<uint64_t> cutoffs_[MOVE_PICKER_STAGE_SZ][JOB_CUTOFF_INDEX_SZ] = {};
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+static_assert(std::atomic<size_t>::is_always_lock_free);
+
+// PV line found by the job
+struct JobLine {
+  SoFBotApi::SearchResult result;
+  size_t jobId;                                // The job which found the line
+  std::chrono::steady_clock::time_point time;  // Time when the line was found
+  JobStatsSnapshot stats;                      // Statistics of the job at time `time`
+};
 
 // Shared data between jobs, which allows them to communicate with each other and with outer world
 class JobCommunicator {
@@ -85,19 +217,45 @@ public:
     startTime_ = Clock::now();
     limits_ = limits;
     lines_.clear();
+    bestMove_ = SoFCore::Move::null();
+    bestMoveStability_ = 0;
+    turn_ = 0;
+    turnNodes_ = 0;
   }
 
+  // Sets the number of jobs which will run the search. This function must be called after
+  // `reset()` and must not be called when jobs are running.
+  inline void setJobCount(const size_t jobCount) { turnActive_.assign(jobCount, true); }
+
   // Indicates that the job has finished to search on depth `depth`. Returns `true` if it was the
   // first job to finish search on this depth, otherwise returns false.
   inline bool finishDepth(size_t depth) {
     return depth_.compare_exchange_strong(depth, depth + 1, std::memory_order_acq_rel);
   }
 
+  // Indicates that `move` is the best move on the last completed iteration. Returns the number of
+  // consecutive completed iterations (including this one) on which `move` was the best
+  size_t updateBestMove(SoFCore::Move move);
+
   // Adds a new PV line
-  void addLine(SoFBotApi::SearchResult line);
+  void addLine(JobLine line);
 
   // Returns all the unhandled PV lines
-  std::vector<SoFBotApi::SearchResult> extractLines();
+  std::vector<JobLine> extractLines();
+
+  // The functions below are used in deterministic mode. In this mode, the jobs take turns in a
+  // fixed order, and only the job which holds the turn may search
+
+  // Waits until job `jobId` gets the turn or the search is stopped
+  void waitTurn(size_t jobId);
+
+  // Passes the turn from job `jobId` to the next job and waits until job `jobId` gets the turn
+  // again. `nodes` is the number of nodes searched by the job during its turn. If the total number
+  // of nodes reaches the limit, then the search is stopped
+  void passTurn(size_t jobId, uint64_t nodes);
+
+  // Removes job `jobId` from the order of turns. Must be called when the job finishes
+  void leaveTurns(size_t jobId);
 
 private:
   using Clock = std::chrono::steady_clock;
@@ -106,71 +264,49 @@ private:
   // `lock_` is held by the current thread
   Event checkEventUnlocked();
 
+  // Returns the next job after `jobId` which takes part in the turns. Must be called only when
+  // `lock_` is held by the current thread
+  size_t nextTurnUnlocked(size_t jobId) const;
+
   std::atomic<size_t> depth_ = 1;
   std::atomic<size_t> stopped_ = false;
   Clock::time_point startTime_ = Clock::now();
   SearchLimits limits_ = SearchLimits::withInfiniteTime();
 
   std::mutex lock_;
-  std::vector<SoFBotApi::SearchResult> lines_;
+  std::vector<JobLine> lines_;
+  SoFCore::Move bestMove_ = SoFCore::Move::null();
+  size_t bestMoveStability_ = 0;
+  size_t turn_ = 0;
+  uint64_t turnNodes_ = 0;
+  std::vector<bool> turnActive_;
 
   std::condition_variable event_;
+  std::condition_variable turnEvent_;
 };
 
-// Type of job stats
-enum class JobStat : size_t {
-  Nodes,
-  TtHits,
-  TtCutoffHits,
-  PvNodes,
-  NonPvNodes,
-  PvInternalNodes,
-  NonPvInternalNodes,
-  PPEdges,  // PV -> PV transitions
-  PNEdges,  // PV -> non-PV transitions
-  NNEdges,  // non-PV -> non-PV transitions
-  Max       // Fake type to denote the total number of stats
-};
-
-// Number of job stats
-constexpr size_t JOB_STAT_SZ = static_cast<size_t>(JobStat::Max);
-
-// Job statistics. This class is thread-safe if there is no more than one writer thread. If two
-// threads write concurrently, a race condition occurs.
-class JobStats {
-public:
-  // Returns job statistic `stat`. Can be called by reader threads.
-  inline uint64_t get(const JobStat stat) const {
-    return stats_[static_cast<size_t>(stat)].load(std::memory_order_relaxed);
-  }
-
-  // Increments job statistic `stat`. Can be called by a single writer thread.
-  inline void inc(const JobStat stat) {
-    std::atomic<uint64_t> &value = stats_[static_cast<size_t>(stat)];
-    const uint64_t newValue = value.load(std::memory_order_relaxed) + 1;
-    value.store(newValue, std::memory_order_relaxed);
-  }
-
-private:
-  std::atomic<uint64_t> stats_[JOB_STAT_SZ] = {};
-};
-
-static_assert(std::atomic<uint64_t>::is_always_lock_free);
-static_assert(std::atomic<size_t>::is_always_lock_free);
-
 // A class that represents a single search job.
 class Job {
 public:
   inline Job(JobCommunicator &comm, TranspositionTable &tt, SoFEval::ScoreEvaluator &evaluator,
-             const size_t id)
-      : comm_(comm), tt_(tt), evaluator_(evaluator), id_(id) {}
+             HistoryTable &history, const size_t id)
+      : comm_(comm), tt_(tt), evaluator_(evaluator), history_(history), id_(id) {}
 
   // Returns current statistics of the search job. The statistics are updated while the job is
   // running.
   inline const JobStats &stats() const { return stats_; }
 
+  // Returns the identifier of the job
+  inline size_t id() const { return id_; }
+
   // Starts the search job. This function must be called exactly once.
-  void run(const Position &position);
+  void run(const GameState &game);
+
+#ifdef USE_SEARCH_TRACE
+  // Sets the sink into which the job writes the search trace. If `sink` is `nullptr`, then the
+  // trace is not recorded. Must be called before `run()`
+  inline void setTraceSink(TraceSink *sink) { traceSink_ = sink; }
+#endif
 
 private:
   friend class Searcher;
@@ -178,8 +314,10 @@ private:
   JobCommunicator &comm_;
   TranspositionTable &tt_;
   SoFEval::ScoreEvaluator &evaluator_;
+  HistoryTable &history_;
   size_t id_;
   JobStats stats_;
+  TRACE(TraceSink *traceSink_ = nullptr;)
 };
 
 }  // namespace SoFSearch::Private
@@ -20,8 +20,10 @@
 #include <chrono>
 #include <cstdint>
 #include <deque>
+#include <optional>
 #include <sstream>
 #include <string>
+#include <utility>
 
 #include "bot_api/server.h"
 #include "core/board.h"
@@ -29,6 +31,7 @@
 #include "core/movegen.h"
 #include "eval/evaluate.h"
 #include "search/private/limits.h"
+#include "search/private/move_picker.h"
 #include "search/private/types.h"
 #include "util/defer.h"
 #include "util/logging.h"
@@ -56,6 +59,7 @@ public:
   inline double getDouble(const JobStat stat) const { return static_cast<double>(get(stat)); }
 
   inline uint64_t nodes() const { return get(JobStat::Nodes); }
+  inline uint64_t quiescenseNodes() const { return get(JobStat::QuiescenseNodes); }
   inline uint64_t pvNodes() const { return get(JobStat::PvNodes); }
   inline uint64_t nonPvNodes() const { return get(JobStat::NonPvNodes); }
   inline uint64_t otherNodes() const { return nodes() - pvNodes() - nonPvNodes(); }
@@ -75,14 +79,56 @@ public:
            static_cast<double>(get(JobStat::PvInternalNodes) + get(JobStat::NonPvInternalNodes));
   }
 
+  inline uint64_t getDepth(const JobStat stat, const size_t depth) const {
+    return depthStats_[static_cast<size_t>(stat)][depth];
+  }
+
+  inline uint64_t getCutoff(const MovePickerStage stage, const size_t index) const {
+    return cutoffs_[static_cast<size_t>(stage)][index];
+  }
+
   inline void add(const JobStats &jobStats) {
     for (size_t i = 0; i < JOB_STAT_SZ; ++i) {
-      stats_[i] += jobStats.get(static_cast<JobStat>(i));
+      const auto stat = static_cast<JobStat>(i);
+      stats_[i] += jobStats.get(stat);
+      for (size_t depth = 0; depth < JOB_STAT_DEPTH_SZ; ++depth) {
+        depthStats_[i][depth] += jobStats.getDepth(stat, depth);
+      }
+    }
+    for (size_t i = 0; i < MOVE_PICKER_STAGE_SZ; ++i) {
+      for (size_t index = 0; index < JOB_CUTOFF_INDEX_SZ; ++index) {
+        cutoffs_[i][index] += jobStats.getCutoff(static_cast<MovePickerStage>(i), index);
+      }
+    }
+  }
+
+  inline void add(const JobStatsSnapshot &snapshot) {
+    for (size_t i = 0; i < JOB_STAT_SZ; ++i) {
+      stats_[i] += snapshot[i];
     }
   }
 
 private:
   uint64_t stats_[JOB_STAT_SZ] = {};
+  uint64_t depthStats_[JOB_STAT_SZ][JOB_STAT_DEPTH_SZ] = {};
+  uint64_t cutoffs_[MOVE_PICKER_STAGE_SZ][JOB_CUTOFF_INDEX_SZ] = {};
+};
+
+// Pruning technique, for which the statistics are reported
+struct PruningStat {
+  const char *name;
+  JobStat tries;
+  JobStat successes;
+};
+
+constexpr PruningStat PRUNING_STATS[] = {
+    {"Futility", JobStat::FutilityTries, JobStat::FutilityPrunes},
+    {"Razoring", JobStat::RazoringTries, JobStat::RazoringPrunes},
+    {"NullMove", JobStat::NullMoveTries, JobStat::NullMoveReductions},
+    {"ProbCut", JobStat::ProbCutTries, JobStat::ProbCutPrunes},
+    {"LmrResearch", JobStat::LmrTries, JobStat::LmrResearches},
+    {"PvsResearch", JobStat::PvsTries, JobStat::PvsResearches},
+    {"TtCutoff", JobStat::TtCutoffTries, JobStat::TtCutoffHits},
 };
 
 static Move pickRandomMove(Board board) {
@@ -100,10 +146,12 @@ static Move pickRandomMove(Board board) {
 
 class JobRunner::MainThread : public SoFUtil::NoCopyMove {
 public:
-  explicit MainThread(JobRunner &p, const Position &position, const size_t jobCount)
+  explicit MainThread(JobRunner &p, const GameState &game, const size_t jobCount,
+                      const size_t searchId)
       : p_(p),
-        position_(position),
+        game_(game),
         jobCount_(jobCount),
+        searchId_(searchId),
         comm_(p_.comm_),
         server_(p_.server_),
         startTime_(comm_.startTime()),
@@ -112,6 +160,9 @@ public:
   void run() {
     disableReconfiguration();
     SOF_DEFER({ enableReconfiguration(); });
+    if (p_.isDebugMode()) {
+      server_.sendString("Running " + std::to_string(jobCount_) + " jobs");
+    }
     createJobsAndThreads();
     runMainLoop();
     joinThreads();
@@ -149,12 +200,14 @@ private:
   }
 
   void createJobsAndThreads() {
-    SOF_ASSERT(p_.evaluators_.size() == jobCount_);
+    SOF_ASSERT(p_.evaluators_.size() >= jobCount_);
+    SOF_ASSERT(p_.histories_.size() >= jobCount_);
     for (size_t i = 0; i < jobCount_; ++i) {
-      jobs_.emplace_back(comm_, p_.tt_, p_.evaluators_[i], i);
+      jobs_.emplace_back(comm_, p_.tt_, p_.evaluators_[i], p_.histories_[i], i);
+      TRACE(jobs_.back().setTraceSink(p_.traceSink_.get());)
     }
     for (size_t i = 0; i < jobCount_; ++i) {
-      threads_.emplace_back([&job = jobs_[i], this]() { job.run(position_); });
+      threads_.emplace_back([&job = jobs_[i], this]() { job.run(game_); });
     }
   }
 
@@ -170,21 +223,77 @@ private:
     // Normally, the extracted lines will be sorted by depth, but the jobs add them in a quite racy
     // manner, so they may appear in any order. Thus, we sort them to reduce the chaos a little.
     std::sort(lines.begin(), lines.end(),
-              [&](const auto &a, const auto &b) { return a.depth < b.depth; });
+              [&](const auto &a, const auto &b) { return a.result.depth < b.result.depth; });
     for (const auto &line : lines) {
-      server_.sendResult(line, stats_.nodes());
-      if (line.depth > bestDepth_ && !line.pv.empty()) {
-        bestDepth_ = line.depth;
-        bestMove_ = line.pv[0];
+      const SoFBotApi::SearchResult &result = line.result;
+      server_.sendResult(result, stats_.nodes());
+      if (result.depth > bestDepth_ && !result.pv.empty()) {
+        bestDepth_ = result.depth;
+        bestMove_ = result.pv[0];
+        reportIteration(line);
       }
     }
   }
 
+  // Reports the statistics for the iteration which produced `line` as a single JSON line. The
+  // statistics of the job that found the line are exact, while the statistics of other jobs are
+  // taken at the moment of the call, so they are approximate
+  void reportIteration(const JobLine &line) {
+    Stats stats;
+    for (const Job &job : jobs_) {
+      if (job.id() == line.jobId) {
+        stats.add(line.stats);
+      } else {
+        stats.add(job.stats());
+      }
+    }
+    const bool toInfo = p_.isStatsInfo();
+    const bool toFile = p_.statsOut_.is_open();
+    const uint64_t nodes = stats.nodes();
+    const uint64_t iterNodes = nodes - lastNodes_;
+    const uint64_t prevIterNodes = lastIterNodes_;
+    lastNodes_ = nodes;
+    lastIterNodes_ = iterNodes;
+    if (!toInfo && !toFile) {
+      return;
+    }
+
+    const auto ratio = [](const uint64_t a, const uint64_t b) {
+      return b == 0 ? 0.0 : static_cast<double>(a) / static_cast<double>(b);
+    };
+    const uint64_t mainNodes = stats.pvNodes() + stats.nonPvNodes();
+    const auto time = timeElapsed(line.time).count();
+    std::ostringstream stream;
+    stream.precision(4);
+    stream.flags(stream.flags() | std::ostream::fixed);
+    stream << "{\"search\": " << searchId_ << ", \"depth\": " << line.result.depth
+           << ", \"nodes\": " << nodes << ", \"qnodes\": " << stats.quiescenseNodes()
+           << ", \"iter_nodes\": " << iterNodes << ", \"ebf\": " << ratio(iterNodes, prevIterNodes)
+           << ", \"tt_hit_rate\": " << ratio(stats.get(JobStat::TtHits), mainNodes)
+           << ", \"tt_cutoff_rate\": " << ratio(stats.get(JobStat::TtCutoffHits), mainNodes)
+           << ", \"first_move_cutoff_rate\": "
+           << ratio(stats.get(JobStat::FirstMoveCutoffs), stats.get(JobStat::BetaCutoffs))
+           << ", \"time_us\": " << time
+           << ", \"nps\": " << static_cast<uint64_t>(ratio(nodes, time) * 1'000'000) << "}";
+    const std::string json = stream.str();
+
+    if (toInfo) {
+      server_.sendString(json);
+    }
+    if (toFile) {
+      p_.statsOut_ << json << std::endl;
+    }
+  }
+
   microseconds timeElapsed(const steady_clock::time_point &now) const {
     return duration_cast<microseconds>(now - startTime_);
   }
 
   bool mustStop(const steady_clock::time_point &now) const {
+    if (limits_.deterministic) {
+      // The jobs enforce the limits by themselves, as the number of nodes must be exact
+      return false;
+    }
     return stats_.nodes() > limits_.nodes ||
            (limits_.time != TIME_UNLIMITED && timeElapsed(now) > limits_.time);
   }
@@ -214,6 +323,65 @@ private:
                          std::to_string(stats_.get(JobStat::TtCutoffHits)));
       server_.sendString(nodeStream.str());
       server_.sendString(edgeStream.str());
+      printPruningStats();
+      printCutoffStats();
+    }
+  }
+
+  // Prints the histograms of move indices on which beta cutoffs occur, for each move picker stage.
+  // The index is counted among all the legal moves in the node, not only the moves of this stage
+  void printCutoffStats() {
+    const uint64_t cutoffs = stats_.get(JobStat::BetaCutoffs);
+    const uint64_t firstMoveCutoffs = stats_.get(JobStat::FirstMoveCutoffs);
+    std::ostringstream totalStream;
+    totalStream.precision(1);
+    totalStream.flags(totalStream.flags() | std::ostream::fixed);
+    totalStream << "Beta cutoffs: " << cutoffs << " first move = " << firstMoveCutoffs << " ("
+                << (cutoffs == 0 ? 0.0
+                                 : 100.0 * static_cast<double>(firstMoveCutoffs) /
+                                       static_cast<double>(cutoffs))
+                << "%)";
+    server_.sendString(totalStream.str());
+    for (size_t i = 0; i < MOVE_PICKER_STAGE_SZ; ++i) {
+      const auto stage = static_cast<MovePickerStage>(i);
+      std::ostringstream stream;
+      uint64_t total = 0;
+      for (size_t index = 0; index < JOB_CUTOFF_INDEX_SZ; ++index) {
+        const uint64_t count = stats_.getCutoff(stage, index);
+        total += count;
+        if (count != 0) {
+          stream << " " << index << (index + 1 == JOB_CUTOFF_INDEX_SZ ? "+" : "") << " = " << count;
+        }
+      }
+      if (total != 0) {
+        server_.sendString(std::string("Beta cutoffs on stage ") + movePickerStageToStr(stage) +
+                           ": " + std::to_string(total) + " by index:" + stream.str());
+      }
+    }
+  }
+
+  // Prints how often each pruning technique succeeds, in total and for each depth. The depths on
+  // which the technique was never tried are skipped
+  void printPruningStats() {
+    for (const PruningStat &stat : PRUNING_STATS) {
+      std::ostringstream stream;
+      stream.precision(1);
+      stream.flags(stream.flags() | std::ostream::fixed);
+      const auto percent = [](const uint64_t a, const uint64_t b) {
+        return b == 0 ? 0.0 : 100.0 * static_cast<double>(a) / static_cast<double>(b);
+      };
+      const uint64_t tries = stats_.get(stat.tries);
+      const uint64_t successes = stats_.get(stat.successes);
+      stream << stat.name << ": " << successes << "/" << tries << " ("
+             << percent(successes, tries) << "%) by depth:";
+      for (size_t depth = 0; depth < JOB_STAT_DEPTH_SZ; ++depth) {
+        const uint64_t depthTries = stats_.getDepth(stat.tries, depth);
+        if (depthTries != 0) {
+          stream << " " << depth << (depth + 1 == JOB_STAT_DEPTH_SZ ? "+" : "") << " = "
+                 << stats_.getDepth(stat.successes, depth) << "/" << depthTries;
+        }
+      }
+      server_.sendString(stream.str());
     }
   }
 
@@ -250,19 +418,25 @@ private:
   void finishSearch() {
     if (bestMove_ == Move::null()) {
       logWarn(JOB_RUNNER) << "The search didn't find anything; picking a random move";
-      bestMove_ = pickRandomMove(position_.last);
+      bestMove_ = pickRandomMove(game_.board());
     }
+    // Report the exact number of nodes, as the jobs are already joined
+    updateStats();
+    server_.sendNodeCount(stats_.nodes());
     server_.finishSearch(bestMove_);
 
     if (p_.isDebugMode()) {
       server_.sendString(
           "Total search time: " + std::to_string(timeElapsed(steady_clock::now()).count()) + " us");
+      printPruningStats();
+      printCutoffStats();
     }
   }
 
   JobRunner &p_;
-  const Position &position_;
+  const GameState &game_;
   const size_t jobCount_;
+  const size_t searchId_;
   JobCommunicator &comm_;
   SoFBotApi::Server &server_;
   const steady_clock::time_point startTime_;
@@ -275,9 +449,19 @@ private:
   size_t bestDepth_ = 0;
   Move bestMove_ = Move::null();
   Stats stats_;
+  uint64_t lastNodes_ = 0;
+  uint64_t lastIterNodes_ = 0;
 };
 
-JobRunner::JobRunner(SoFBotApi::Server &server) : server_(server), evaluators_(DEFAULT_NUM_JOBS) {}
+JobRunner::JobRunner(SoFBotApi::Server &server, std::shared_ptr<ThreadBudget> budget)
+    : server_(server),
+      budget_(std::move(budget)),
+      evaluators_(DEFAULT_NUM_JOBS),
+      histories_(DEFAULT_NUM_JOBS) {
+  if (budget_) {
+    budget_->attach();
+  }
+}
 
 void JobRunner::clearHash() {
   std::unique_lock lock(applyConfigLock_);
@@ -303,13 +487,49 @@ void JobRunner::setNumJobs(const size_t jobs) {
   tryApplyConfigUnlocked();
 }
 
+#ifdef USE_SEARCH_TRACE
+void JobRunner::setTraceFile(std::string path) {
+  std::unique_lock lock(applyConfigLock_);
+  traceFile_ = std::move(path);
+  needReopenTrace_ = true;
+  tryApplyConfigUnlocked();
+}
+#endif
+
+void JobRunner::setStatsFile(std::string path) {
+  std::unique_lock lock(applyConfigLock_);
+  statsFile_ = std::move(path);
+  needReopenStats_ = true;
+  tryApplyConfigUnlocked();
+}
+
+void JobRunner::setSharedHash(std::string name) {
+  std::unique_lock lock(applyConfigLock_);
+  sharedHashName_ = std::move(name);
+  needReopenSharedHash_ = true;
+  tryApplyConfigUnlocked();
+}
+
+void JobRunner::setBookFile(std::string path) {
+  std::unique_lock lock(applyConfigLock_);
+  bookFile_ = std::move(path);
+  needReopenBook_ = true;
+  tryApplyConfigUnlocked();
+}
+
 void JobRunner::join() {
   if (mainThread_.joinable()) {
-    comm_.stop();
+    stop();
     mainThread_.join();
   }
 }
 
+void JobRunner::clearHistories() {
+  for (HistoryTable &history : histories_) {
+    history.clear();
+  }
+}
+
 void JobRunner::tryApplyConfigUnlocked() {
   if (!canApplyConfig_) {
     return;
@@ -317,42 +537,138 @@ void JobRunner::tryApplyConfigUnlocked() {
   if (evaluators_.size() != numJobs_) {
     evaluators_.resize(numJobs_);
   }
-  if (needClearHash_ || tt_.sizeBytes() != hashSize_) {
-    if (needClearHash_) {
-      lastPosition_ = std::nullopt;
+  if (histories_.size() != numJobs_) {
+    histories_.resize(numJobs_);
+  }
+  if (needReopenSharedHash_) {
+    needReopenSharedHash_ = false;
+    // The shared table contains the positions from other games, so the epoch of the last position
+    // is irrelevant now
+    hasLastPosition_ = false;
+    auto result = tt_.share(sharedHashName_, hashSize_, numJobs_);
+    if (result.isErr()) {
+      logError(JOB_RUNNER) << "Cannot use shared hash table: "
+                           << std::move(result).unwrapErr().description;
+    } else if (!tt_.isEmpty()) {
+      // The shared table may already exist with another size, so we take its size. The table may
+      // be still empty if it's private and not allocated yet, then the requested size is kept
+      hashSize_ = tt_.sizeBytes();
     }
+  }
+  if (needClearHash_) {
+    hasLastPosition_ = false;
+    clearHistories();
+  }
+  // The empty table is allocated only when the search starts, as the hash size may still change
+  if (!tt_.isEmpty() && (needClearHash_ || tt_.sizeBytes() != hashSize_)) {
     tt_.resize(hashSize_, needClearHash_, numJobs_);
-    needClearHash_ = false;
     hashSize_ = tt_.sizeBytes();
   }
+  needClearHash_ = false;
   if (needNewGame_) {
     needNewGame_ = false;
-    if (lastPosition_) {
-      lastPosition_ = std::nullopt;
+    clearHistories();
+    if (hasLastPosition_) {
+      hasLastPosition_ = false;
       tt_.resetEpoch();
     }
   }
+  if (needReopenBook_) {
+    needReopenBook_ = false;
+    book_.reset();
+    if (!bookFile_.empty()) {
+      auto book = Book::open(bookFile_);
+      if (book.isOk()) {
+        book_ = std::move(book).unwrap();
+      } else {
+        logError(JOB_RUNNER) << "Cannot open book: " << std::move(book).unwrapErr().description;
+      }
+    }
+  }
+  if (needReopenStats_) {
+    needReopenStats_ = false;
+    statsOut_ = std::ofstream();
+    if (!statsFile_.empty()) {
+      statsOut_.open(statsFile_, std::ios_base::out | std::ios_base::app);
+      if (!statsOut_.is_open()) {
+        logError(JOB_RUNNER) << "Cannot open stats file \"" << statsFile_ << "\"";
+      }
+    }
+  }
+#ifdef USE_SEARCH_TRACE
+  if (needReopenTrace_) {
+    needReopenTrace_ = false;
+    traceSink_.reset();
+    if (!traceFile_.empty()) {
+      auto sink = TraceSink::open(traceFile_);
+      if (sink.isOk()) {
+        traceSink_ = std::move(sink).unwrap();
+      } else {
+        logError(JOB_RUNNER) << "Cannot open trace file: "
+                             << std::move(sink).unwrapErr().description;
+      }
+    }
+  }
+#endif
 }
 
 void JobRunner::start(const Position &position, const SearchLimits &limits) {
   join();
-  comm_.reset(limits);
   setPosition(position);
-  mainThread_ = std::thread([this, position, jobCount = this->numJobs_]() {
-    MainThread mt(*this, position, jobCount);
+  if (book_ && limits.canStopEarly) {
+    const Move bookMove = book_->pick(game_.board(), bookSelection_);
+    if (bookMove != Move::null()) {
+      // Report the move from another thread, as the search is expected to finish asynchronously
+      mainThread_ = std::thread([this, bookMove]() {
+        server_.sendString("Book move");
+        server_.finishSearch(bookMove);
+      });
+      return;
+    }
+  }
+  size_t requested = 0;
+  {
+    std::unique_lock lock(applyConfigLock_);
+    if (tt_.isEmpty()) {
+      tt_.resize(hashSize_, true, numJobs_);
+      hashSize_ = tt_.sizeBytes();
+    }
+    // Keep the configuration unchanged while the search waits for the threads from the budget. It
+    // is re-enabled by the main thread when the search finishes
+    canApplyConfig_ = false;
+    requested = numJobs_;
+  }
+  comm_.reset(limits);
+  // The game state is not modified until the main thread is joined, so it is safe to share it
+  mainThread_ = std::thread([this, requested, searchId = searchCount_++]() {
+    // The lease is taken here instead of `start()`, so the thread processing the commands is not
+    // blocked while the search is queued and still can stop it. If the search is stopped before
+    // it gets the threads, it runs with one thread, which finishes immediately. The lease is
+    // returned to the budget when the search finishes
+    std::optional<ThreadBudget::Lease> lease;
+    if (budget_) {
+      lease = budget_->acquire(requested, [&]() { return comm_.isStopped(); });
+    }
+    if (!lease) {
+      lease.emplace(budget_ ? 1 : requested);
+    }
+    const size_t jobCount = lease->threads();
+    comm_.setJobCount(jobCount);
+    MainThread mt(*this, game_, jobCount, searchId);
     mt.run();
   });
 }
 
-void JobRunner::setPosition(Position position) {
-  if (!lastPosition_) {
-    lastPosition_ = std::move(position);
+void JobRunner::setPosition(const Position &position) {
+  const size_t oldSize = game_.position().moves.size();
+  const size_t common = game_.update(position);
+  if (!hasLastPosition_) {
+    hasLastPosition_ = true;
     return;
   }
-  const size_t common = commonPrefix(*lastPosition_, position);
   if (common != COMMON_PREFIX_NONE) {
-    const size_t diff = SoFUtil::absDiff(common, lastPosition_->moves.size()) +
-                        SoFUtil::absDiff(common, position.moves.size());
+    const size_t diff =
+        SoFUtil::absDiff(common, oldSize) + SoFUtil::absDiff(common, position.moves.size());
     if (diff == 0) {
       // Do nothing
     } else if (diff <= 5) {
@@ -363,11 +679,20 @@ void JobRunner::setPosition(Position position) {
   } else {
     tt_.resetEpoch();
   }
-  lastPosition_ = std::move(position);
 }
 
-void JobRunner::stop() { comm_.stop(); }
+void JobRunner::stop() {
+  comm_.stop();
+  if (budget_) {
+    budget_->wakeWaiters();
+  }
+}
 
-JobRunner::~JobRunner() { join(); }
+JobRunner::~JobRunner() {
+  join();
+  if (budget_) {
+    budget_->detach();
+  }
+}
 
 }  // namespace SoFSearch::Private
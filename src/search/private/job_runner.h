@@ -20,15 +20,21 @@
 
 #include <atomic>
 #include <cstddef>
+#include <fstream>
+#include <memory>
 #include <mutex>
-#include <optional>
+#include <string>
 #include <thread>
 #include <vector>
 
 #include "eval/score.h"
+#include "search/private/book.h"
 #include "search/private/job.h"
+#include "search/private/trace.h"
 #include "search/private/transposition_table.h"
 #include "search/private/types.h"
+#include "search/private/util.h"
+#include "search/thread_budget.h"
 
 namespace SoFBotApi {
 class Server;
@@ -44,7 +50,9 @@ public:
   // Default number of jobs for `JobRunner`
   static constexpr size_t DEFAULT_NUM_JOBS = 1;
 
-  explicit JobRunner(SoFBotApi::Server &server);
+  // Creates the job runner. If `budget` is not `nullptr`, then the number of jobs in each search is
+  // additionally limited by the threads taken from `budget`
+  explicit JobRunner(SoFBotApi::Server &server, std::shared_ptr<ThreadBudget> budget = nullptr);
   ~JobRunner();
 
   // Stops the search. This operation is asynchronous, so the jobs may work for some time after you
@@ -63,6 +71,10 @@ public:
   // may be deferred until the search is stopped.
   void setHashSize(size_t size);
 
+  // Returns the hash table size (in bytes). If the table is shared, its size is determined by the
+  // process which created the shared segment
+  inline size_t hashSize() const { return hashSize_; }
+
   // Indicates that the hash table must be cleared. The clear operation may be deferred until the
   // search is stopped.
   void clearHash();
@@ -85,33 +97,97 @@ public:
   // Returns `true` if debug mode is enabled
   inline bool isDebugMode() const { return debugMode_.load(std::memory_order_acquire); }
 
+  // Enables or disables sending per-iteration statistics to server as info strings
+  inline void setStatsInfo(const bool enable) {
+    statsInfo_.store(enable, std::memory_order_release);
+  }
+
+  // Returns `true` if per-iteration statistics are sent to server
+  inline bool isStatsInfo() const { return statsInfo_.load(std::memory_order_acquire); }
+
+  // Sets the file into which per-iteration statistics are appended as JSON lines. If `path` is
+  // empty, then the statistics are not written to file. The change may be deferred until the
+  // search is stopped.
+  void setStatsFile(std::string path);
+
+  // Places the hash table into the shared memory segment `name`, so it is shared with other
+  // processes that use the same name. If `name` is empty, the hash table becomes private. See
+  // `TranspositionTable` for details on how the size and the epoch of the shared table are managed.
+  // The change may be deferred until the search is stopped.
+  void setSharedHash(std::string name);
+
+  // Sets the opening book file in Polyglot format. If `path` is empty, then the book is not used.
+  // The book is used only for the searches that can stop early (i.e. the ones under time control),
+  // as other searches are mostly used for analysis. The change may be deferred until the search is
+  // stopped.
+  void setBookFile(std::string path);
+
+  // Sets the strategy to pick a move from the opening book
+  inline void setBookSelection(const Book::Selection selection) { bookSelection_ = selection; }
+
+#ifdef USE_SEARCH_TRACE
+  // Sets the file into which the search trace is written. If `path` is empty, then the trace is not
+  // recorded. The change may be deferred until the search is stopped.
+  void setTraceFile(std::string path);
+#endif
+
 private:
   // Does nothing if the search is running (i.e. `canApplyConfig_` is `false`). Otherwise, applies
   // new configuration if it has changed since last successful call to this function.  Must be
   // called under `applyConfigLock_`
   void tryApplyConfigUnlocked();
 
-  // Helper method. Acknowledges that search in the position `position` is being started
-  void setPosition(Position position);
+  // Helper method. Acknowledges that search in the position `position` is being started and
+  // prepares the game state for it
+  void setPosition(const Position &position);
+
+  // Resets the history tables of all the jobs. Must be called under `applyConfigLock_` while the
+  // search is not running
+  void clearHistories();
 
   class MainThread;
 
   JobCommunicator comm_;
   TranspositionTable tt_;
   SoFBotApi::Server &server_;
+  std::shared_ptr<ThreadBudget> budget_;
   std::vector<SoFEval::ScoreEvaluator> evaluators_;
+  std::vector<HistoryTable> histories_;
 
   std::thread mainThread_;
   std::mutex applyConfigLock_;
   std::atomic<bool> debugMode_ = false;
+  std::atomic<bool> statsInfo_ = false;
   bool canApplyConfig_ = true;
 
-  std::optional<Position> lastPosition_;
+  // Game state of the last search. It is kept between the searches, so the new positions that
+  // extend the previous one are prepared incrementally
+  GameState game_;
+  bool hasLastPosition_ = false;
 
   size_t hashSize_ = TranspositionTable::DEFAULT_SIZE;
   size_t numJobs_ = DEFAULT_NUM_JOBS;
   bool needClearHash_ = false;
   bool needNewGame_ = false;
+
+  std::string sharedHashName_;
+  bool needReopenSharedHash_ = false;
+
+  std::unique_ptr<Book> book_;
+  std::string bookFile_;
+  bool needReopenBook_ = false;
+  Book::Selection bookSelection_ = Book::Selection::Weighted;
+
+  std::string statsFile_;
+  std::ofstream statsOut_;
+  bool needReopenStats_ = false;
+  size_t searchCount_ = 0;
+
+#ifdef USE_SEARCH_TRACE
+  std::string traceFile_;
+  std::unique_ptr<TraceSink> traceSink_;
+  bool needReopenTrace_ = false;
+#endif
 };
 
 }  // namespace SoFSearch::Private
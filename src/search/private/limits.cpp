@@ -90,7 +90,7 @@ inline static milliseconds calculateMaxTime(const SoFCore::Board &board,
 SearchLimits SearchLimits::withTimeControl(const SoFCore::Board &board,
                                            const SoFBotApi::TimeControl &timeControl) {
   const milliseconds maxTime = calculateMaxTime(board, timeControl);
-  return SearchLimits{DEPTH_UNLIMITED, NODES_UNLIMITED, maxTime, timeControl};
+  return SearchLimits{DEPTH_UNLIMITED, NODES_UNLIMITED, maxTime, timeControl, true};
 }
 
 }  // namespace SoFSearch::Private
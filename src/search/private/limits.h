@@ -18,12 +18,14 @@
 #ifndef SOF_SEARCH_PRIVATE_LIMITS_INCLUDED
 #define SOF_SEARCH_PRIVATE_LIMITS_INCLUDED
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
 
 #include "bot_api/types.h"
+#include "search/private/consts.h"
 
 namespace SoFCore {
 struct Board;
@@ -44,6 +46,14 @@ struct SearchLimits {
   std::chrono::milliseconds time = TIME_UNLIMITED;
   // Time control (default-constructed if not present)
   SoFBotApi::TimeControl timeControl;
+  // If `true`, then the search may finish before the limits are reached, if its result is unlikely
+  // to change (e.g. when there is only one legal move). This is allowed only for the searches under
+  // time control, as the other search modes are mostly used for analysis
+  bool canStopEarly = false;
+  // If `true`, then the search result depends only on the position, the limits and the number of
+  // jobs. To achieve this, the jobs take turns instead of running in parallel, and the time limit
+  // is replaced with the node limit. Useful for reproducible benchmarking
+  bool deterministic = false;
 
   // Constructs `SearchLimits` with infinite time
   inline static SearchLimits withInfiniteTime() { return SearchLimits{}; }
@@ -63,6 +73,24 @@ struct SearchLimits {
     return SearchLimits{DEPTH_UNLIMITED, NODES_UNLIMITED, time, SoFBotApi::TimeControl{}};
   }
 
+  // Turns on deterministic mode, see `deterministic` field for details. The time limit is converted
+  // into the node limit at the rate of `Deterministic::NODES_PER_MS`. Returns `true` if such
+  // conversion took place
+  inline bool makeDeterministic() {
+    deterministic = true;
+    canStopEarly = false;
+    if (time == TIME_UNLIMITED) {
+      return false;
+    }
+    const auto ms = static_cast<uint64_t>(std::max<int64_t>(time.count(), 1));
+    const uint64_t timeNodes = ms > NODES_UNLIMITED / Deterministic::NODES_PER_MS
+                                   ? NODES_UNLIMITED
+                                   : ms * Deterministic::NODES_PER_MS;
+    nodes = std::min(nodes, timeNodes);
+    time = TIME_UNLIMITED;
+    return true;
+  }
+
   // Constructs `SearchLimits` for given time control. This function also determines thinking time
   // based on the given time control.
   static SearchLimits withTimeControl(const SoFCore::Board &board,
@@ -30,6 +30,26 @@ namespace SoFSearch::Private {
 using SoFCore::Board;
 using SoFCore::Move;
 
+const char *movePickerStageToStr(const MovePickerStage stage) {
+  switch (stage) {
+    case MovePickerStage::Start:
+      return "start";
+    case MovePickerStage::HashMove:
+      return "hash";
+    case MovePickerStage::Capture:
+      return "capture";
+    case MovePickerStage::SimplePromote:
+      return "promote";
+    case MovePickerStage::Killer:
+      return "killer";
+    case MovePickerStage::History:
+      return "history";
+    case MovePickerStage::End:
+      return "end";
+  }
+  return "?";
+}
+
 void sortMvvLva(const Board &board, Move *moves, const size_t count) {
   constexpr uint8_t victimOrd[16] = {8, 8, 0, 16, 24, 32, 40, 0, 8, 8, 0, 16, 24, 32, 40, 0};
   constexpr uint8_t attackerOrd[16] = {0, 6, 1, 5, 4, 3, 2, 0, 0, 6, 1, 5, 4, 3, 2, 0};
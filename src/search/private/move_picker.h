@@ -45,6 +45,12 @@ enum class MovePickerStage {
 
 SOF_ENUM_COMPARE(MovePickerStage, int)
 
+// Number of move picker stages
+constexpr size_t MOVE_PICKER_STAGE_SZ = static_cast<size_t>(MovePickerStage::End) + 1;
+
+// Returns the name of move picker stage `stage`
+const char *movePickerStageToStr(MovePickerStage stage);
+
 class KillerLine;
 class HistoryTable;
 
@@ -0,0 +1,119 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "search/private/trace.h"
+
+#include <utility>
+
+#include "util/misc.h"
+
+namespace SoFSearch::Private {
+
+using SoFUtil::Err;
+using SoFUtil::IOError;
+using SoFUtil::Ok;
+using SoFUtil::Result;
+
+const char *traceEventKindToStr(const TraceEventKind kind) {
+  switch (kind) {
+    case TraceEventKind::Enter:
+      return "enter";
+    case TraceEventKind::Exit:
+      return "exit";
+    case TraceEventKind::QEnter:
+      return "qenter";
+    case TraceEventKind::QExit:
+      return "qexit";
+    case TraceEventKind::Prune:
+      return "prune";
+    case TraceEventKind::Tt:
+      return "tt";
+    case TraceEventKind::Cutoff:
+      return "cutoff";
+    case TraceEventKind::Max:
+      break;
+  }
+  return "?";
+}
+
+const char *tracePruneToStr(const TracePrune prune) {
+  switch (prune) {
+    case TracePrune::Draw:
+      return "draw";
+    case TracePrune::Repetition:
+      return "repetition";
+    case TracePrune::Futility:
+      return "futility";
+    case TracePrune::Razoring:
+      return "razoring";
+    case TracePrune::ProbCut:
+      return "probcut";
+    case TracePrune::Delta:
+      return "delta";
+    case TracePrune::Max:
+      break;
+  }
+  return "?";
+}
+
+const char *traceTtToStr(const TraceTt tt) {
+  switch (tt) {
+    case TraceTt::Miss:
+      return "miss";
+    case TraceTt::Hit:
+      return "hit";
+    case TraceTt::Cutoff:
+      return "cutoff";
+    case TraceTt::Max:
+      break;
+  }
+  return "?";
+}
+
+Result<std::unique_ptr<TraceSink>, IOError> TraceSink::open(const std::string &path) {
+  std::ofstream out(path, std::ios_base::out | std::ios_base::binary);
+  if (!out.is_open()) {
+    return Err(IOError{"Unable to open file \"" + path + "\""});
+  }
+  out.write(TRACE_MAGIC, sizeof(TRACE_MAGIC));
+  return Ok(std::unique_ptr<TraceSink>(new TraceSink(std::move(out))));
+}
+
+void TraceSink::write(const size_t jobId, const TraceEvent *events, const size_t count) {
+  const TraceChunkHeader header{static_cast<uint32_t>(jobId), static_cast<uint32_t>(count)};
+  std::unique_lock guard(lock_);
+  out_.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out_.write(reinterpret_cast<const char *>(events),
+             static_cast<std::streamsize>(count * sizeof(TraceEvent)));
+  out_.flush();
+}
+
+Tracer::Tracer(TraceSink *sink, const size_t jobId)
+    : sink_(sink),
+      jobId_(jobId),
+      buffer_(sink ? std::make_unique<TraceEvent[]>(BUFFER_SIZE) : nullptr) {}
+
+void Tracer::flush() {
+  if (size_ == 0) {
+    return;
+  }
+  SOF_ASSERT(sink_);
+  sink_->write(jobId_, buffer_.get(), size_);
+  size_ = 0;
+}
+
+}  // namespace SoFSearch::Private
@@ -0,0 +1,151 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef SOF_SEARCH_PRIVATE_TRACE_INCLUDED
+#define SOF_SEARCH_PRIVATE_TRACE_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "config.h"
+#include "util/ioutil.h"
+#include "util/no_copy_move.h"
+#include "util/result.h"
+
+// If the search trace is enabled, then it expands to its arguments, otherwise it does nothing. It
+// works in the same way as `DIAGNOSTIC` macro
+#ifdef USE_SEARCH_TRACE
+#define TRACE(...) __VA_ARGS__
+#else
+#define TRACE(...)
+#endif
+
+namespace SoFSearch::Private {
+
+// The trace file consists of `TRACE_MAGIC` followed by chunks. Each chunk starts with
+// `TraceChunkHeader` and contains `TraceChunkHeader::count` instances of `TraceEvent`. The values
+// are stored in native byte order
+constexpr char TRACE_MAGIC[8] = {'S', 'o', 'F', 'T', 'r', 'a', 'c', 'e'};
+
+// Kind of the trace event
+enum class TraceEventKind : uint8_t {
+  Enter = 0,   // Entered the main search
+  Exit = 1,    // Exited the main search, `score` is the result
+  QEnter = 2,  // Entered the quiescense search
+  QExit = 3,   // Exited the quiescense search, `score` is the result
+  Prune = 4,   // The node was pruned, `arg` is `TracePrune`
+  Tt = 5,      // Transposition table was probed, `arg` is `TraceTt`
+  Cutoff = 6,  // Beta cutoff, `index` is the move index and `arg` is the move picker stage
+  Max = 7      // Fake kind to denote the total number of kinds
+};
+
+// Reason for pruning the node
+enum class TracePrune : uint8_t {
+  Draw = 0,
+  Repetition = 1,
+  Futility = 2,
+  Razoring = 3,
+  ProbCut = 4,
+  Delta = 5,
+  Max = 6
+};
+
+// Result of transposition table probe
+enum class TraceTt : uint8_t { Miss = 0, Hit = 1, Cutoff = 2, Max = 3 };
+
+// Single event in the trace. The fields which don't make sense for the event kind are zero. In the
+// quiescense search, `depth` is minus the number of plies from the start of quiescense search
+struct TraceEvent {
+  TraceEventKind kind;
+  uint8_t arg;
+  uint16_t idepth;
+  int16_t depth;
+  int16_t alpha;
+  int16_t beta;
+  int16_t score;
+  uint32_t index;
+};
+
+static_assert(sizeof(TraceEvent) == 16);
+
+struct TraceChunkHeader {
+  uint32_t jobId;
+  uint32_t count;
+};
+
+static_assert(sizeof(TraceChunkHeader) == 8);
+
+// Returns the name of the enum value. Used to print the summary of the trace
+const char *traceEventKindToStr(TraceEventKind kind);
+const char *tracePruneToStr(TracePrune prune);
+const char *traceTtToStr(TraceTt tt);
+
+// The file to which the jobs write their traces. This class is thread-safe
+class TraceSink : public SoFUtil::NoCopyMove {
+public:
+  // Creates the sink which writes into the file `path`
+  static SoFUtil::Result<std::unique_ptr<TraceSink>, SoFUtil::IOError> open(
+      const std::string &path);
+
+  // Writes a chunk with events of job `jobId` into the file
+  void write(size_t jobId, const TraceEvent *events, size_t count);
+
+private:
+  explicit TraceSink(std::ofstream out) : out_(std::move(out)) {}
+
+  std::mutex lock_;
+  std::ofstream out_;
+};
+
+// Per-job trace recorder. The events are accumulated in the buffer, which is flushed into
+// `TraceSink` when it becomes full. If no sink is given, the events are ignored
+class Tracer : public SoFUtil::NoCopyMove {
+public:
+  // Number of events in the buffer
+  static constexpr size_t BUFFER_SIZE = 65536;
+
+  Tracer(TraceSink *sink, size_t jobId);
+  ~Tracer() { flush(); }
+
+  inline void add(const TraceEvent &event) {
+    if (!sink_) {
+      return;
+    }
+    buffer_[size_++] = event;
+    if (size_ == BUFFER_SIZE) {
+      flush();
+    }
+  }
+
+  // Writes all the buffered events into the sink
+  void flush();
+
+private:
+  TraceSink *sink_;
+  size_t jobId_;
+  std::unique_ptr<TraceEvent[]> buffer_;
+  size_t size_ = 0;
+};
+
+}  // namespace SoFSearch::Private
+
+#endif  // SOF_SEARCH_PRIVATE_TRACE_INCLUDED
@@ -18,7 +18,9 @@
 #include "search/private/transposition_table.h"
 
 #include <algorithm>
+#include <chrono>
 #include <limits>
+#include <thread>
 #include <utility>
 
 #include "util/parallel.h"
@@ -27,6 +29,11 @@
 namespace SoFSearch::Private {
 
 using SoFCore::board_hash_t;
+using SoFUtil::IOError;
+
+// If the shared table is just created by another process, it may not be initialized yet. Wait for
+// this time before giving up
+constexpr auto SHARED_INIT_TIMEOUT = std::chrono::seconds(1);
 
 void doClear(TranspositionTable::Entry *table, const size_t size, const size_t jobs) {
   SoFUtil::processSegmentParallel(0, size, jobs, [table](const size_t left, const size_t right) {
@@ -48,7 +55,11 @@ int32_t TranspositionTable::Data::weight(const uint8_t curEpoch) const {
   return result;
 }
 
-void TranspositionTable::clear(const size_t jobs) { doClear(table_.get(), size_, jobs); }
+void TranspositionTable::clear(const size_t jobs) {
+  if (!isShared()) {
+    doClear(table_, size_, jobs);
+  }
+}
 
 TranspositionTable::Data TranspositionTable::load(const board_hash_t key) const {
   const size_t idx = key & (size_ - 1);
@@ -69,16 +80,19 @@ void TranspositionTable::prefetch(const board_hash_t key) {
   SoFUtil::prefetch<PrefetchKind::Read, PrefetchLocality::L1>(&table_[idx]);
 }
 
-void TranspositionTable::resize(size_t maxSize, const bool clearTable, const size_t jobs) {
+size_t TranspositionTable::entryCount(size_t maxSize) {
   maxSize = std::max<size_t>(maxSize, 1 << 20);
-
-  // Determine the new table size
-  size_t newSize = 1;
-  while (newSize <= maxSize) {
-    newSize <<= 1;
+  size_t size = 1;
+  while (size <= maxSize) {
+    size <<= 1;
   }
-  newSize >>= 1;
-  newSize /= sizeof(Entry);
+  size >>= 1;
+  return size / sizeof(Entry);
+}
+
+void TranspositionTable::resize(const size_t maxSize, const bool clearTable, const size_t jobs) {
+  // The shared table cannot be resized, as other processes may use it
+  const size_t newSize = isShared() ? size_ : entryCount(maxSize);
   if (newSize == size_) {
     if (clearTable) {
       clear(jobs);
@@ -122,10 +136,110 @@ void TranspositionTable::resize(size_t maxSize, const bool clearTable, const siz
         });
   }
 
-  table_ = std::move(newData);
+  privateTable_ = std::move(newData);
+  table_ = privateTable_.get();
   size_ = newSize;
 }
 
+// Registers one more user of the shared segment with the counter `users`. Returns `false` if the
+// counter has already dropped to zero, i.e. the last user stopped using the segment and is going to
+// unlink it. The segment cannot be used then
+static bool tryAttachShared(std::atomic<uint32_t> &users) {
+  uint32_t count = users.load(std::memory_order_relaxed);
+  while (count != 0) {
+    if (users.compare_exchange_weak(count, count + 1, std::memory_order_acq_rel,
+                                    std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void TranspositionTable::makePrivate(const size_t size, const size_t jobs) {
+  // Do not use `std::make_unique` here, as we want the array to be uninitialized
+  privateTable_.reset(new Entry[size]);
+  table_ = privateTable_.get();
+  size_ = size;
+  doClear(table_, size_, jobs);
+  releaseShared();
+}
+
+void TranspositionTable::releaseShared() {
+  if (!shared_) {
+    return;
+  }
+  if (sharedHeader_->users.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    shared_->unlink();
+  }
+  shared_.reset();
+  sharedHeader_ = nullptr;
+}
+
+SoFUtil::Result<std::monostate, IOError> TranspositionTable::share(const std::string &name,
+                                                                   const size_t maxSize,
+                                                                   const size_t jobs) {
+  if (name.empty()) {
+    if (isShared()) {
+      makePrivate(entryCount(maxSize), jobs);
+    }
+    return SoFUtil::Ok(std::monostate{});
+  }
+
+  const size_t newSize = entryCount(maxSize);
+  const auto deadline = std::chrono::steady_clock::now() + SHARED_INIT_TIMEOUT;
+  std::unique_ptr<SoFUtil::SharedMemory> memory;
+  SharedHeader *header = nullptr;
+  for (;;) {
+    SOF_TRY_ASSIGN(memory, SoFUtil::SharedMemory::open(
+                               name, sizeof(SharedHeader) + newSize * sizeof(Entry)));
+    if (memory->size() < sizeof(SharedHeader)) {
+      return SoFUtil::Err(IOError{"Shared hash table \"" + name + "\" is too small"});
+    }
+    header = static_cast<SharedHeader *>(memory->data());
+
+    // The created segment is filled with zeros, which means that all the entries are cleared. So we
+    // just need to set the size, register this process as the first user and mark the segment as
+    // initialized. As the user is registered before the segment is marked, the counter of users of
+    // the initialized segment drops to zero only once, when the last user stops using it
+    if (memory->isCreated()) {
+      header->size = newSize;
+      header->users.store(1, std::memory_order_relaxed);
+      header->magic.store(SHARED_MAGIC, std::memory_order_release);
+      break;
+    }
+
+    while (header->magic.load(std::memory_order_acquire) != SHARED_MAGIC) {
+      if (std::chrono::steady_clock::now() > deadline) {
+        return SoFUtil::Err(IOError{"Shared memory \"" + name + "\" is not a hash table"});
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const size_t size = header->size;
+    if (size == 0 || (size & (size - 1)) != 0 ||
+        memory->size() != sizeof(SharedHeader) + size * sizeof(Entry)) {
+      return SoFUtil::Err(IOError{"Shared hash table \"" + name + "\" has invalid size"});
+    }
+    if (tryAttachShared(header->users)) {
+      break;
+    }
+
+    // The segment is going to be unlinked by its last user. Wait until it happens and open the
+    // segment again, so a new one is created
+    if (std::chrono::steady_clock::now() > deadline) {
+      return SoFUtil::Err(IOError{"Shared hash table \"" + name + "\" is being removed"});
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  releaseShared();
+  privateTable_.reset();
+  table_ = reinterpret_cast<Entry *>(header + 1);
+  size_ = header->size;
+  shared_ = std::move(memory);
+  sharedHeader_ = header;
+  return SoFUtil::Ok(std::monostate{});
+}
+
 void TranspositionTable::store(board_hash_t key, TranspositionTable::Data value) {
   const size_t idx = key & (size_ - 1);
   const uint8_t epoch = epoch_;
@@ -138,9 +252,8 @@ void TranspositionTable::store(board_hash_t key, TranspositionTable::Data value)
   entry.assignRelaxed(value, key);
 }
 
-TranspositionTable::TranspositionTable()
-    : size_(DEFAULT_SIZE / sizeof(Entry)), table_(new Entry[size_]) {
-  clear(1);
-}
+TranspositionTable::TranspositionTable() : size_(0), table_(nullptr) {}
+
+TranspositionTable::~TranspositionTable() { releaseShared(); }
 
 }  // namespace SoFSearch::Private
@@ -22,16 +22,35 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <string>
+#include <variant>
 
 #include "bot_api/types.h"
 #include "core/move.h"
 #include "core/types.h"
 #include "eval/score.h"
+#include "util/ioutil.h"
 #include "util/no_copy_move.h"
+#include "util/result.h"
+#include "util/shared_memory.h"
 
 namespace SoFSearch::Private {
 
-// Stores the information about the already searched nodes in a hash table
+// Stores the information about the already searched nodes in a hash table.
+//
+// The table may be placed into a named shared memory segment (see `share()`), so the processes
+// which use the segment with the same name share one table. In this case:
+// - the table size is chosen by the process which created the segment, and cannot be changed until
+//   the segment is removed. Other processes use the existing size, and `resize()` only clears the
+//   table (if requested)
+// - the epoch is kept per process, so `growEpoch()` and `resetEpoch()` don't affect the other
+//   processes. The entries stored by other processes are just aged against the epoch of this one
+// - `clear()` does nothing, as the other processes may still need the entries
+// - the segment header counts the processes which use the table. The last process that stops
+//   using it unlinks the segment. The creator of the segment counts itself before the segment is
+//   initialized, and the other processes count themselves only while the counter is non-zero, so
+//   no process can start using the segment which is about to be unlinked. If a process terminates
+//   abnormally, the counter is never decremented, so the segment stays until it is removed manually
 class TranspositionTable : public SoFUtil::NoCopy {
 public:
   // Transposition table entry which contains a search result for some position
@@ -110,8 +129,15 @@ public:
   // Default size of the transposition table
   constexpr static size_t DEFAULT_SIZE = 1 << 25;
 
+  // Creates an empty table. It must be resized before use, so no memory is spent on the table of
+  // default size if another size is requested later
   TranspositionTable();
 
+  ~TranspositionTable();
+
+  // Returns `true` if the table was not resized yet after construction
+  inline bool isEmpty() const { return size_ == 0; }
+
   // Resizes the hash table. The new table size (in bytes) will be the maximum power of two not
   // exceeding `max(1048576, maxSize)`. If `clearTable` is `true`, the table is cleared after
   // resize. Otherwise, we try to retain some information that already exists in the hash table.
@@ -120,6 +146,19 @@ public:
   // This function is not thread-safe. No other thread should use the table while resizing.
   void resize(size_t maxSize, bool clearTable, size_t jobs);
 
+  // Places the table into the shared memory segment `name`, creating the segment with the table
+  // size not exceeding `maxSize` if it doesn't exist. If `name` is empty, the table is moved back
+  // into the private memory of the process and gets cleared. The contents of the private table are
+  // not copied into the shared one. If an error occurs, the table is left private. If the segment
+  // is being unlinked by its last user, waits until it is unlinked and creates a new one.
+  //
+  // This function is not thread-safe. No other thread should use the table while sharing.
+  SoFUtil::Result<std::monostate, SoFUtil::IOError> share(const std::string &name, size_t maxSize,
+                                                          size_t jobs);
+
+  // Returns `true` if the table is placed into the shared memory segment
+  inline bool isShared() const { return shared_ != nullptr; }
+
   // Indicates that `amount` epochs have passed. It will help to evict irrelevant items from the
   // hash table. Note that this function is not thread-safe
   inline void growEpoch(const uint8_t amount = 1) { epoch_ += amount; }
@@ -136,6 +175,7 @@ public:
   inline bool isCurrentEpoch(const Data data) const { return data.epoch_ == epoch_; }
 
   // Clears the hash table. The hash table is cleared in a multithreaded way, using `jobs` threads.
+  // Does nothing if the table is shared.
   //
   // This function is not thread-safe. No other thread should use the table while resizing.
   void clear(size_t jobs);
@@ -167,14 +207,38 @@ private:
     }
   };
 
+  // Header of the shared memory segment, the entries are placed right after it
+  struct alignas(64) SharedHeader {
+    std::atomic<uint64_t> magic;  // Set to `SHARED_MAGIC` when the segment is initialized
+    uint64_t size;
+    std::atomic<uint32_t> users;  // Number of processes which use the table
+  };
+
+  static constexpr uint64_t SHARED_MAGIC = 0x3230545453464f53;  // "SOFSTT02"
+
   friend void doClear(Entry *table, size_t size, size_t jobs);
 
+  // Returns the number of entries in the table of size not exceeding `max(1048576, maxSize)` bytes
+  static size_t entryCount(size_t maxSize);
+
+  // Replaces the current table with the private one with `size` entries. Old entries are lost
+  void makePrivate(size_t size, size_t jobs);
+
+  // Stops using the shared memory segment, if any. The segment is unlinked if this process was its
+  // last user
+  void releaseShared();
+
   static_assert(std::atomic<SoFCore::board_hash_t>::is_always_lock_free);
   static_assert(std::atomic<Data>::is_always_lock_free);
   static_assert(sizeof(Entry) == 16);
+  static_assert(std::atomic<uint64_t>::is_always_lock_free);
+  static_assert(std::atomic<uint32_t>::is_always_lock_free);
 
   size_t size_;  // Number of entries, must be power of two
-  std::unique_ptr<Entry[]> table_;
+  Entry *table_;
+  std::unique_ptr<Entry[]> privateTable_;
+  std::unique_ptr<SoFUtil::SharedMemory> shared_;
+  SharedHeader *sharedHeader_ = nullptr;
   uint8_t epoch_ = 0;
 };
 
@@ -18,9 +18,17 @@
 #include "search/private/types.h"
 
 #include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include "util/misc.h"
 
 namespace SoFSearch::Private {
 
+using SoFCore::Board;
+using SoFCore::board_hash_t;
+using SoFCore::Move;
+
 size_t commonPrefix(const Position &p1, const Position &p2) {
   if (p1.first != p2.first) {
     return COMMON_PREFIX_NONE;
@@ -34,4 +42,58 @@ size_t commonPrefix(const Position &p1, const Position &p2) {
   return limit;
 }
 
+// Removes the positions before the last irreversible move from `history`, as they cannot repeat
+static void trimHistory(std::vector<board_hash_t> &history, const Board &board) {
+  const size_t keep = std::min<size_t>(history.size(), board.moveCounter);
+  history.erase(history.begin(), std::prev(history.end(), static_cast<ptrdiff_t>(keep)));
+}
+
+static bool isPrefix(const std::vector<Move> &prefix, const std::vector<Move> &moves) {
+  return prefix.size() <= moves.size() && std::equal(prefix.begin(), prefix.end(), moves.begin());
+}
+
+void Position::assign(const Board &newFirst, std::vector<Move> newMoves) {
+  if (first != newFirst || !isPrefix(moves, newMoves)) {
+    *this = Position::from(newFirst, std::move(newMoves));
+    return;
+  }
+  for (size_t idx = moves.size(); idx < newMoves.size(); ++idx) {
+    moveMake(last, newMoves[idx]);
+  }
+  moves = std::move(newMoves);
+}
+
+GameState::GameState() : GameState(Position::from(Board::initialPosition(), {})) {}
+
+GameState::GameState(Position position) : position_(std::move(position)) { rebuild(); }
+
+size_t GameState::update(Position position) {
+  const size_t common = commonPrefix(position_, position);
+  if (common != position_.moves.size()) {
+    position_ = std::move(position);
+    rebuild();
+    return common;
+  }
+  Board board = position_.last;
+  for (size_t idx = common; idx < position.moves.size(); ++idx) {
+    history_.push_back(board.hash);
+    moveMake(board, position.moves[idx]);
+  }
+  position_ = std::move(position);
+  SOF_ASSERT(board == position_.last);
+  trimHistory(history_, position_.last);
+  return common;
+}
+
+void GameState::rebuild() {
+  Board board = position_.first;
+  history_.clear();
+  history_.reserve(position_.moves.size());
+  for (const Move move : position_.moves) {
+    history_.push_back(board.hash);
+    moveMake(board, move);
+  }
+  trimHistory(history_, position_.last);
+}
+
 }  // namespace SoFSearch::Private
@@ -18,6 +18,8 @@
 #ifndef SOF_SEARCH_PRIVATE_TYPES_INCLUDED
 #define SOF_SEARCH_PRIVATE_TYPES_INCLUDED
 
+#include <algorithm>
+#include <cstddef>
 #include <vector>
 
 #include "core/board.h"
@@ -39,6 +41,10 @@ struct Position {
     }
     return position;
   }
+
+  // Replaces the position with the one built from `newFirst` and `newMoves`. If the current moves
+  // are a prefix of `newMoves`, then only the remaining moves are applied to calculate `last`
+  void assign(const SoFCore::Board &newFirst, std::vector<SoFCore::Move> newMoves);
 };
 
 // Special return value for `commonPrefix` function
@@ -48,6 +54,55 @@ constexpr size_t COMMON_PREFIX_NONE = static_cast<size_t>(-1);
 // of positions differ, returns `COMMON_PREFIX_NONE`
 size_t commonPrefix(const Position &p1, const Position &p2);
 
+// Game state prepared for the search, which is shared between all the jobs in read-only mode. It
+// contains the final position together with the hashes required for repetition detection
+class GameState {
+public:
+  // Creates the state for the initial position without any moves
+  GameState();
+
+  explicit GameState(Position position);
+
+  // Updates the state to `position`. If the current position is the prefix of `position`, then only
+  // the new moves are applied. Returns `commonPrefix()` between the old position and the new one
+  size_t update(Position position);
+
+  inline const Position &position() const { return position_; }
+
+  // Returns the final board of the game
+  inline const SoFCore::Board &board() const { return position_.last; }
+
+  // Returns the hashes of the positions occurred in the game before `board()`, in chronological
+  // order. Only the positions after the last irreversible move are kept
+  inline const std::vector<SoFCore::board_hash_t> &history() const { return history_; }
+
+private:
+  // Recalculates the history, replaying all the moves from the start
+  void rebuild();
+
+  Position position_;
+  std::vector<SoFCore::board_hash_t> history_;
+};
+
+// Returns `true` if the position `board` must be considered as a draw by repetition. `hashes`
+// contains the hashes of the preceding positions in chronological order: the first `historySize`
+// of them come from the game history (see `GameState::history()`), and the remaining ones up to
+// index `top` (exclusive) come from the current search path. The position is a draw if it already
+// occurred on the search path, or it occurred in the game history at least twice. We walk only over
+// the positions after the last irreversible move, as the older positions cannot be repeated
+inline bool isRepetition(const SoFCore::board_hash_t *hashes, const size_t historySize,
+                         const size_t top, const SoFCore::Board &board) {
+  const size_t limit = std::min<size_t>(board.moveCounter, top);
+  size_t historyCount = 0;
+  for (size_t dist = 4; dist <= limit; dist += 2) {
+    const size_t idx = top - dist;
+    if (hashes[idx] == board.hash && (idx >= historySize || ++historyCount == 2)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 }  // namespace SoFSearch::Private
 
 #endif  // SOF_SEARCH_PRIVATE_TYPES_INCLUDED
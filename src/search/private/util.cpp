@@ -17,12 +17,36 @@
 
 #include "search/private/util.h"
 
+#include <algorithm>
 #include <utility>
 
 namespace SoFSearch::Private {
 
 using SoFCore::board_hash_t;
 
+void HistoryTable::age() {
+  for (size_t i = 0; i < TAB_SIZE; ++i) {
+    tab_[i] /= 2;
+  }
+}
+
+void HistoryTable::clear() { std::fill(tab_.get(), tab_.get() + TAB_SIZE, 0); }
+
+void RootMoveList::reorder(const SoFCore::Move bestMove) {
+  std::stable_sort(items_.begin(), items_.end(), [&](const Item &a, const Item &b) {
+    const bool aBest = a.move == bestMove;
+    const bool bBest = b.move == bestMove;
+    if (aBest != bBest) {
+      return aBest;
+    }
+    return a.nodes > b.nodes;
+  });
+  for (Item &item : items_) {
+    item.nodes = 0;
+    item.score = -SoFEval::SCORE_INF;
+  }
+}
+
 void RepetitionTable::grow() {
   const size_t newBucketCount = bucketCount_ * 2;
   const size_t newMask = (newBucketCount - 1) * BUCKET_SIZE;
@@ -18,12 +18,16 @@
 #ifndef SOF_SEARCH_PRIVATE_UTIL_INCLUDED
 #define SOF_SEARCH_PRIVATE_UTIL_INCLUDED
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "core/move.h"
 #include "core/types.h"
+#include "eval/score.h"
+#include "search/private/consts.h"
 #include "util/misc.h"
 
 namespace SoFSearch::Private {
@@ -51,25 +55,100 @@ private:
   SoFCore::Move second_ = SoFCore::Move::null();
 };
 
-// History table used for history heuristics
+// History table used for history heuristics. The entries are kept in range `[-MAX, MAX]` using
+// gravity-style updates: the closer the entry is to the bound, the smaller the effect of each new
+// bonus. So, the table never overflows and recent updates are able to outweigh old ones. The table
+// is kept between the searches and aged before each new search
 class HistoryTable {
 public:
-  HistoryTable() : tab_(std::make_unique<uint64_t[]>(TAB_SIZE)) {}
+  // Maximum absolute value of the table entry
+  static constexpr int32_t MAX = 16384;
 
-  inline uint64_t &operator[](const SoFCore::Move move) { return tab_[indexOf(move)]; }
-  inline uint64_t operator[](const SoFCore::Move move) const { return tab_[indexOf(move)]; }
+  HistoryTable() : tab_(std::make_unique<int16_t[]>(TAB_SIZE)) {}
+
+  inline int16_t operator[](const SoFCore::Move move) const { return tab_[indexOf(move)]; }
+
+  // Returns the bonus applied after a beta cutoff on depth `depth`. The same value is used as a
+  // malus for the quiet moves which didn't produce a cutoff
+  inline static int32_t bonus(const int32_t depth) {
+    return std::min(History::BONUS_MUL * depth * depth, History::MAX_BONUS);
+  }
+
+  // Adds `bonus` to the entry for `move`. `bonus` must be in range `[-MAX, MAX]`. Negative bonuses
+  // are used as maluses for the moves that failed to produce a cutoff
+  inline void update(const SoFCore::Move move, const int32_t bonus) {
+    int16_t &value = tab_[indexOf(move)];
+    const int32_t absBonus = (bonus < 0) ? -bonus : bonus;
+    const int32_t oldValue = value;
+    value = static_cast<int16_t>(oldValue + bonus - oldValue * absBonus / MAX);
+  }
+
+  // Divides all the entries by two, so the values collected during previous searches don't
+  // dominate over the fresh ones
+  void age();
+
+  // Resets all the entries to zero
+  void clear();
 
 private:
   inline constexpr static size_t indexOf(const SoFCore::Move move) {
     return (static_cast<size_t>(move.src) << 6) | static_cast<size_t>(move.dst);
   }
 
-  std::unique_ptr<uint64_t[]> tab_;
+  std::unique_ptr<int16_t[]> tab_;
 
   // NOLINTNEXTLINE(bugprone-implicit-widening-of-multiplication-result)
   static constexpr size_t TAB_SIZE = 64 * 64;
 };
 
+static_assert(HistoryTable::MAX <= 32767, "History table entries must fit into `int16_t`");
+
+// List of legal moves in the root node. The list is preserved between the iterations of iterative
+// deepening, and collects the statistics for each move, which are used to reorder the moves before
+// the next iteration
+class RootMoveList {
+public:
+  struct Item {
+    SoFCore::Move move;
+    // Number of nodes spent to search this move on the current iteration
+    uint64_t nodes;
+    // Score of this move on the current iteration, or `-SCORE_INF` if it's unknown (i.e. the move
+    // was not searched yet or failed low)
+    SoFEval::score_t score;
+  };
+
+  inline bool empty() const { return items_.empty(); }
+  inline size_t size() const { return items_.size(); }
+
+  inline const Item &operator[](const size_t idx) const { return items_[idx]; }
+
+  inline std::vector<Item>::const_iterator begin() const { return items_.begin(); }
+  inline std::vector<Item>::const_iterator end() const { return items_.end(); }
+
+  // Adds move `move` to the end of the list
+  inline void add(const SoFCore::Move move) {
+    items_.push_back(Item{move, 0, -SoFEval::SCORE_INF});
+  }
+
+  // Returns the item for move `move`, or `nullptr` if the move is not present in the list
+  inline Item *find(const SoFCore::Move move) {
+    for (Item &item : items_) {
+      if (item.move == move) {
+        return &item;
+      }
+    }
+    return nullptr;
+  }
+
+  // Reorders the moves before the next iteration. `bestMove` goes first, and the remaining moves
+  // are sorted by the number of nodes spent on them, in descending order. Then, the statistics are
+  // reset
+  void reorder(SoFCore::Move bestMove);
+
+private:
+  std::vector<Item> items_;
+};
+
 // Small hash table to track draw by repetitions
 class RepetitionTable {
 public:
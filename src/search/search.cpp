@@ -20,12 +20,15 @@
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "bot_api/api_base.h"
 #include "bot_api/options.h"
+#include "bot_api/server.h"
 #include "config.h"
 #include "core/board.h"
 #include "core/move.h"
@@ -82,7 +85,7 @@ public:
   }
 
   ApiResult setPosition(const Board &board, const Move *moves, const size_t count) override {
-    position_ = Position::from(board, std::vector<Move>(moves, moves + count));
+    position_.assign(board, std::vector<Move>(moves, moves + count));
     return ApiResult::Ok;
   }
 
@@ -114,14 +117,15 @@ public:
     return ApiResult::Ok;
   }
 
-  Engine() : options_(makeOptions(this)) {}
+  explicit Engine(std::shared_ptr<ThreadBudget> budget)
+      : options_(makeOptions(this)), budget_(std::move(budget)) {}
 
   ~Engine() override { SOF_ASSERT_MSG("Server was not disconnected properly", !server_); }
 
 private:
   ApiResult connect(SoFBotApi::Server *server) override {
     server_ = server;
-    runner_.emplace(*server_);
+    runner_.emplace(*server_, budget_);
     return ApiResult::Ok;
   }
 
@@ -131,9 +135,35 @@ private:
     server_ = nullptr;
   }
 
-  ApiResult setBool(const std::string &, bool) override { return ApiResult::Ok; }
-  ApiResult setEnum(const std::string &, size_t) override { return ApiResult::Ok; }
-  ApiResult setString(const std::string &, const std::string &) override { return ApiResult::Ok; }
+  ApiResult setBool(const std::string &key, const bool value) override {
+    if (key == "Stats Info") {
+      runner_->setStatsInfo(value);
+    } else if (key == "Deterministic") {
+      deterministic_ = value;
+    }
+    return ApiResult::Ok;
+  }
+  ApiResult setEnum(const std::string &key, const size_t index) override {
+    if (key == "Book Selection") {
+      runner_->setBookSelection(static_cast<Private::Book::Selection>(index));
+    }
+    return ApiResult::Ok;
+  }
+  ApiResult setString(const std::string &key, const std::string &value) override {
+    if (key == "Stats File") {
+      runner_->setStatsFile(value);
+    } else if (key == "Shared Hash") {
+      runner_->setSharedHash(value);
+    } else if (key == "BookFile") {
+      runner_->setBookFile(value);
+    }
+#ifdef USE_SEARCH_TRACE
+    if (key == "Trace File") {
+      runner_->setTraceFile(value);
+    }
+#endif
+    return ApiResult::Ok;
+  }
 
   ApiResult setInt(const std::string &key, const int64_t value) override {
     if (key == "Hash") {
@@ -158,24 +188,43 @@ private:
   }
 
   static SoFBotApi::OptionStorage makeOptions(Engine *engine) {
-    return SoFBotApi::OptionBuilder(engine)
-        .addInt("Hash", 1, Private::TranspositionTable::DEFAULT_SIZE >> 20, 131'072)
+    SoFBotApi::OptionBuilder builder(engine);
+    builder.addInt("Hash", 1, Private::TranspositionTable::DEFAULT_SIZE >> 20, 131'072)
         .addInt("Threads", 1, Private::JobRunner::DEFAULT_NUM_JOBS, 512)
         .addAction("Clear hash")
-        .options();
+        .addBool("Stats Info", false)
+        .addBool("Deterministic", false)
+        .addString("Stats File", "")
+        .addString("Shared Hash", "")
+        .addString("BookFile", "")
+        .addEnum("Book Selection", {"Weighted", "Best"}, 0);
+#ifdef USE_SEARCH_TRACE
+    builder.addString("Trace File", "");
+#endif
+    return builder.options();
   }
 
-  ApiResult doSearch(const Private::SearchLimits &limits) {
+  ApiResult doSearch(Private::SearchLimits limits) {
+    if (deterministic_ && limits.makeDeterministic()) {
+      server_->sendString("Deterministic mode: time limit replaced with " +
+                          std::to_string(limits.nodes) + " nodes");
+    }
     runner_->start(position_, limits);
     return ApiResult::Ok;
   }
 
   SoFBotApi::OptionStorage options_;
   SoFBotApi::Server *server_ = nullptr;
+  std::shared_ptr<ThreadBudget> budget_;
+  bool deterministic_ = false;
   std::optional<Private::JobRunner> runner_;
   Position position_ = Position::from(Board::initialPosition(), {});
 };
 
-std::unique_ptr<SoFBotApi::Client> makeEngine() { return std::make_unique<Engine>(); }
+std::unique_ptr<SoFBotApi::Client> makeEngine() { return makeEngine(nullptr); }
+
+std::unique_ptr<SoFBotApi::Client> makeEngine(std::shared_ptr<ThreadBudget> budget) {
+  return std::make_unique<Engine>(std::move(budget));
+}
 
 }  // namespace SoFSearch
@@ -21,12 +21,17 @@
 #include <memory>
 
 #include "bot_api/client.h"
+#include "search/thread_budget.h"
 
 namespace SoFSearch {
 
 // Creates the chess engine. It uses `SoFBotApi::Client` as an interface
 std::unique_ptr<SoFBotApi::Client> makeEngine();
 
+// Creates the chess engine which takes the search threads from `budget`. Multiple engines may share
+// the same budget, so they don't use more threads in total than the budget allows
+std::unique_ptr<SoFBotApi::Client> makeEngine(std::shared_ptr<ThreadBudget> budget);
+
 }  // namespace SoFSearch
 
 #endif  // SOF_SEARCH_SEARCH_INCLUDED
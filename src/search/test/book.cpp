@@ -0,0 +1,129 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "search/private/book.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/board.h"
+#include "core/move.h"
+#include "core/move_parser.h"
+#include "core/polyglot.h"
+
+using SoFCore::Board;
+using SoFCore::Move;
+using SoFCore::moveParse;
+using SoFCore::polyglotKey;
+using SoFCore::polyglotMoveEncode;
+using SoFSearch::Private::Book;
+using SoFSearch::Private::BookEntry;
+
+// Book with a few entries, which is written into a temporary file for the test
+class BookTest : public testing::Test {
+protected:
+  void SetUp() override {
+    initial_ = Board::initialPosition();
+    afterE4_ = initial_;
+    moveMake(afterE4_, moveParse("e2e4", initial_));
+
+    const uint64_t key = polyglotKey(initial_);
+    std::vector<BookEntry> entries = {
+        {key, encode(initial_, "e2e4"), 10, 0},
+        {key, encode(initial_, "d2d4"), 30, 0},
+        {key, encode(initial_, "g1f3"), 0, 0},
+        // Move which is illegal in this position, like the one coming from key collision
+        {key, static_cast<uint16_t>((12 << 6) | 36), 1000, 0},
+        {key - 1, encode(initial_, "c2c4"), 1000, 0},
+        {key + 1, encode(initial_, "b1c3"), 1000, 0},
+    };
+    std::stable_sort(entries.begin(), entries.end(),
+                     [](const BookEntry &a, const BookEntry &b) { return a.key < b.key; });
+
+    path_ = testing::TempDir() + "sofcheck_book_test.bin";
+    std::vector<unsigned char> data(entries.size() * BookEntry::SIZE);
+    for (size_t i = 0; i < entries.size(); ++i) {
+      entries[i].write(data.data() + i * BookEntry::SIZE);
+    }
+    std::ofstream out(path_, std::ios::binary);
+    out.write(reinterpret_cast<const char *>(data.data()),
+              static_cast<std::streamsize>(data.size()));
+    out.close();
+
+    auto book = Book::open(path_);
+    ASSERT_TRUE(book.isOk());
+    book_ = std::move(book).unwrap();
+  }
+
+  void TearDown() override {
+    book_.reset();
+    std::remove(path_.c_str());
+  }
+
+  static uint16_t encode(const Board &board, const char *move) {
+    return polyglotMoveEncode(board, moveParse(move, board));
+  }
+
+  Board initial_;
+  Board afterE4_;
+  std::string path_;
+  std::unique_ptr<Book> book_;
+};
+
+TEST_F(BookTest, PickBest) {
+  EXPECT_EQ(book_->pick(initial_, Book::Selection::Best), moveParse("d2d4", initial_));
+  EXPECT_EQ(book_->pick(afterE4_, Book::Selection::Best), Move::null());
+}
+
+TEST_F(BookTest, PickWeighted) {
+  const Move e2e4 = moveParse("e2e4", initial_);
+  const Move d2d4 = moveParse("d2d4", initial_);
+  bool foundE2e4 = false;
+  bool foundD2d4 = false;
+  for (int i = 0; i < 200; ++i) {
+    // Moves with zero weight and illegal moves must be never picked
+    const Move move = book_->pick(initial_, Book::Selection::Weighted);
+    ASSERT_TRUE(move == e2e4 || move == d2d4);
+    foundE2e4 |= move == e2e4;
+    foundD2d4 |= move == d2d4;
+  }
+  EXPECT_TRUE(foundE2e4);
+  EXPECT_TRUE(foundD2d4);
+  EXPECT_EQ(book_->pick(afterE4_, Book::Selection::Weighted), Move::null());
+}
+
+TEST(SoFSearch, BookEntry_ReadWrite) {
+  const BookEntry entry{0x0123'4567'89ab'cdef, 0x1234, 0x5678, 0x9abc'def0};
+  unsigned char data[BookEntry::SIZE];
+  entry.write(data);
+  EXPECT_EQ(data[0], 0x01);
+  EXPECT_EQ(data[7], 0xef);
+  EXPECT_EQ(data[8], 0x12);
+  EXPECT_EQ(data[10], 0x56);
+  EXPECT_EQ(data[15], 0xf0);
+  const BookEntry read = BookEntry::read(data);
+  EXPECT_EQ(read.key, entry.key);
+  EXPECT_EQ(read.move, entry.move);
+  EXPECT_EQ(read.weight, entry.weight);
+  EXPECT_EQ(read.learn, entry.learn);
+}
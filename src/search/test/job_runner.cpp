@@ -0,0 +1,61 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "search/private/job_runner.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "bot_api/api_base.h"
+#include "bot_api/server.h"
+#include "bot_api/types.h"
+#include "core/move.h"
+
+using SoFBotApi::ApiResult;
+using SoFSearch::Private::JobRunner;
+
+namespace {
+
+// Server which ignores everything sent to it
+class NullServer final : public SoFBotApi::Server {
+public:
+  ApiResult finishSearch(SoFCore::Move) override { return ApiResult::Ok; }
+  ApiResult sendString(const char *) override { return ApiResult::Ok; }
+  ApiResult sendResult(const SoFBotApi::SearchResult &, uint64_t) override { return ApiResult::Ok; }
+  ApiResult sendNodeCount(uint64_t) override { return ApiResult::Ok; }
+  ApiResult sendHashHits(uint64_t) override { return ApiResult::Ok; }
+  ApiResult sendHashFull(SoFBotApi::permille_t) override { return ApiResult::Ok; }
+  ApiResult sendCurrMove(SoFCore::Move, size_t) override { return ApiResult::Ok; }
+  ApiResult reportError(const char *) override { return ApiResult::Ok; }
+  ApiResult connect(SoFBotApi::Client *) override { return ApiResult::Ok; }
+  void disconnect() override {}
+};
+
+}  // namespace
+
+TEST(SoFSearch, JobRunner_SharedHashFailure) {
+  NullServer server;
+  JobRunner runner(server);
+  constexpr size_t HASH_SIZE = 4 << 20;
+  runner.setHashSize(HASH_SIZE);
+  // The table is not allocated until the first search, so it's still empty when the share fails.
+  // The requested hash size must be kept in this case
+  runner.setSharedHash("invalid/name");
+  EXPECT_EQ(runner.hashSize(), HASH_SIZE);
+}
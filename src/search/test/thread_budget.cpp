@@ -0,0 +1,67 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "search/thread_budget.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <optional>
+#include <thread>
+
+using SoFSearch::ThreadBudget;
+
+TEST(SoFSearch, ThreadBudget_Acquire) {
+  ThreadBudget budget(4);
+  budget.attach();
+  budget.attach();
+  const auto never = []() { return false; };
+  std::optional<ThreadBudget::Lease> first = budget.acquire(8, never);
+  ASSERT_TRUE(first);
+  EXPECT_EQ(first->threads(), 2U);
+  std::optional<ThreadBudget::Lease> second = budget.acquire(1, never);
+  ASSERT_TRUE(second);
+  EXPECT_EQ(second->threads(), 1U);
+  first.reset();
+  std::optional<ThreadBudget::Lease> third = budget.acquire(3, never);
+  ASSERT_TRUE(third);
+  EXPECT_EQ(third->threads(), 2U);
+}
+
+TEST(SoFSearch, ThreadBudget_CancelAcquire) {
+  ThreadBudget budget(1);
+  budget.attach();
+  budget.attach();
+  std::optional<ThreadBudget::Lease> lease = budget.acquire(1, []() { return false; });
+  ASSERT_TRUE(lease);
+
+  std::atomic<bool> stopped = false;
+  std::optional<ThreadBudget::Lease> queued;
+  std::thread waiter([&]() { queued = budget.acquire(1, [&]() { return stopped.load(); }); });
+  stopped = true;
+  budget.wakeWaiters();
+  waiter.join();
+  EXPECT_FALSE(queued);
+
+  // The cancelled wait must not take the threads, so the budget is still exhausted until the
+  // first lease is released
+  std::thread next([&]() { queued = budget.acquire(1, []() { return false; }); });
+  lease.reset();
+  next.join();
+  ASSERT_TRUE(queued);
+  EXPECT_EQ(queued->threads(), 1U);
+}
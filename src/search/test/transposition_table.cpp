@@ -0,0 +1,67 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "search/private/transposition_table.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <random>
+#include <string>
+
+#include "bot_api/types.h"
+#include "config.h"
+#include "core/move.h"
+#include "core/types.h"
+
+using SoFCore::Move;
+using SoFCore::MoveKind;
+using SoFSearch::Private::TranspositionTable;
+
+#ifdef USE_POSIX_SHM
+TEST(SoFSearch, TranspositionTable_Share) {
+  const std::string name = "sofcheck-test-" + std::to_string(std::random_device{}());
+  constexpr size_t MB = 1 << 20;
+  constexpr SoFCore::board_hash_t KEY = 0x0123456789abcdef;
+  const TranspositionTable::Data data(Move{MoveKind::Simple, 52, 36, 0}, 42, 5,
+                                      SoFBotApi::PositionCostBound::Exact);
+
+  TranspositionTable first;
+  ASSERT_TRUE(first.share(name, 2 * MB, 1).isOk());
+  EXPECT_EQ(first.sizeBytes(), 2 * MB);
+  {
+    // The second table uses the size of the existing segment
+    TranspositionTable second;
+    ASSERT_TRUE(second.share(name, 4 * MB, 1).isOk());
+    EXPECT_EQ(second.sizeBytes(), 2 * MB);
+    first.store(KEY, data);
+    const TranspositionTable::Data loaded = second.load(KEY);
+    EXPECT_TRUE(loaded.isValid());
+    EXPECT_EQ(loaded.move(), data.move());
+    EXPECT_EQ(loaded.score(), 42);
+    EXPECT_EQ(loaded.depth(), 5);
+    ASSERT_TRUE(first.share("", MB, 1).isOk());
+    EXPECT_FALSE(first.isShared());
+  }
+
+  // The last user has unlinked the segment, so the new one is created with the requested size
+  TranspositionTable third;
+  ASSERT_TRUE(third.share(name, 4 * MB, 1).isOk());
+  EXPECT_EQ(third.sizeBytes(), 4 * MB);
+  EXPECT_FALSE(third.load(KEY).isValid());
+}
+#endif
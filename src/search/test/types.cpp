@@ -0,0 +1,179 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "search/private/types.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+#include "core/board.h"
+#include "core/move.h"
+#include "core/move_parser.h"
+
+using SoFCore::Board;
+using SoFCore::board_hash_t;
+using SoFCore::Move;
+using SoFSearch::Private::COMMON_PREFIX_NONE;
+using SoFSearch::Private::GameState;
+using SoFSearch::Private::Position;
+
+// Builds the position from `first` and the moves in UCI notation
+static Position makePosition(const Board &first, std::initializer_list<const char *> moves) {
+  std::vector<Move> parsed;
+  Board board = first;
+  for (const char *str : moves) {
+    const Move move = SoFCore::moveParse(str, board);
+    EXPECT_TRUE(move.isWellFormed(board.side)) << str;
+    moveMake(board, move);
+    parsed.push_back(move);
+  }
+  return Position::from(first, std::move(parsed));
+}
+
+// Returns the hashes of all the positions occurred in the game before its last position
+static std::vector<board_hash_t> allHashes(const Position &position) {
+  std::vector<board_hash_t> hashes;
+  Board board = position.first;
+  for (const Move move : position.moves) {
+    hashes.push_back(board.hash);
+    moveMake(board, move);
+  }
+  return hashes;
+}
+
+TEST(SoFSearch, GameState_Extend) {
+  const Board start = Board::initialPosition();
+  GameState state;
+  EXPECT_TRUE(state.history().empty());
+  EXPECT_EQ(state.board(), start);
+
+  const Position twoMoves = makePosition(start, {"g1f3", "g8f6"});
+  EXPECT_EQ(state.update(twoMoves), 0);
+  EXPECT_EQ(state.history(), allHashes(twoMoves));
+  EXPECT_EQ(state.board(), twoMoves.last);
+
+  const Position fiveMoves = makePosition(start, {"g1f3", "g8f6", "b1c3", "b8c6", "c3b1"});
+  EXPECT_EQ(state.update(fiveMoves), 2);
+  EXPECT_EQ(state.history(), allHashes(fiveMoves));
+  EXPECT_EQ(state.history().size(), 5);
+  EXPECT_EQ(state.board(), fiveMoves.last);
+}
+
+TEST(SoFSearch, GameState_GoBack) {
+  const Board start = Board::initialPosition();
+  const Position threeMoves = makePosition(start, {"g1f3", "g8f6", "b1c3"});
+  const Position twoMoves = makePosition(start, {"g1f3", "g8f6"});
+  GameState state(threeMoves);
+  EXPECT_EQ(state.history().size(), 3);
+
+  EXPECT_EQ(state.update(twoMoves), 2);
+  EXPECT_EQ(state.history(), allHashes(twoMoves));
+  EXPECT_EQ(state.board(), twoMoves.last);
+
+  const Position otherLine = makePosition(start, {"g1f3", "b8c6"});
+  EXPECT_EQ(state.update(otherLine), 1);
+  EXPECT_EQ(state.board(), otherLine.last);
+  EXPECT_EQ(state.history(), allHashes(otherLine));
+}
+
+TEST(SoFSearch, GameState_Replace) {
+  const Board start = Board::initialPosition();
+  GameState state(makePosition(start, {"g1f3", "g8f6"}));
+
+  const Board other =
+      Board::fromFen("rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1").unwrap();
+  const Position replaced = makePosition(other, {"g8f6", "b1c3"});
+  EXPECT_EQ(state.update(replaced), COMMON_PREFIX_NONE);
+  EXPECT_EQ(state.history(), allHashes(replaced));
+  EXPECT_EQ(state.position().first, other);
+  EXPECT_EQ(state.board(), replaced.last);
+}
+
+TEST(SoFSearch, GameState_TrimAtIrreversibleMove) {
+  const Board start = Board::initialPosition();
+  const Position position = makePosition(start, {"g1f3", "g8f6", "e2e4", "b8c6", "f3g1"});
+  const std::vector<board_hash_t> hashes = allHashes(position);
+
+  // The pawn move resets the move counter, so only the positions after it are kept
+  GameState state(position);
+  EXPECT_EQ(position.last.moveCounter, 2);
+  EXPECT_EQ(state.history(), std::vector<board_hash_t>(hashes.end() - 2, hashes.end()));
+
+  // Incremental update must trim the history in the same way
+  GameState incremental(makePosition(start, {"g1f3", "g8f6"}));
+  EXPECT_EQ(incremental.history().size(), 2);
+  EXPECT_EQ(incremental.update(position), 2);
+  EXPECT_EQ(incremental.history(), state.history());
+}
+
+TEST(SoFSearch, IsRepetition_GameHistory) {
+  const Board start = Board::initialPosition();
+
+  // The position occurred once in the game history, so it is not a draw yet
+  const GameState once(makePosition(start, {"g1f3", "g8f6", "f3g1", "f6g8"}));
+  EXPECT_EQ(once.board().hash, start.hash);
+  EXPECT_FALSE(SoFSearch::Private::isRepetition(once.history().data(), once.history().size(),
+                                                once.history().size(), once.board()));
+
+  // Twice in the game history, so the position is a draw
+  const GameState twice(makePosition(
+      start, {"g1f3", "g8f6", "f3g1", "f6g8", "g1f3", "g8f6", "f3g1", "f6g8"}));
+  EXPECT_EQ(twice.board().hash, start.hash);
+  EXPECT_TRUE(SoFSearch::Private::isRepetition(twice.history().data(), twice.history().size(),
+                                               twice.history().size(), twice.board()));
+
+  // The repetitions before the irreversible move are not taken into account
+  const GameState afterPawn(makePosition(
+      start, {"g1f3", "g8f6", "f3g1", "f6g8", "g1f3", "g8f6", "f3g1", "f6g8", "e2e4"}));
+  EXPECT_TRUE(afterPawn.history().empty());
+  EXPECT_FALSE(SoFSearch::Private::isRepetition(afterPawn.history().data(), 0, 0,
+                                                afterPawn.board()));
+}
+
+TEST(SoFSearch, IsRepetition_SearchPath) {
+  const Board start = Board::initialPosition();
+
+  // The root position is taken from the game where it already occurred once. Returning to it
+  // during the search is enough to consider it a draw, though it would take one more repetition
+  // in the game history
+  const GameState state(makePosition(start, {"g1f3", "g8f6", "f3g1", "f6g8"}));
+  std::vector<board_hash_t> hashes = state.history();
+  const size_t historySize = hashes.size();
+
+  Board board = state.board();
+  for (const char *str : {"b1c3", "b8c6", "c3b1", "c6b8"}) {
+    const size_t top = hashes.size();
+    EXPECT_FALSE(SoFSearch::Private::isRepetition(hashes.data(), historySize, top, board)) << str;
+    hashes.push_back(board.hash);
+    moveMake(board, SoFCore::moveParse(str, board));
+  }
+  EXPECT_EQ(board.hash, start.hash);
+  EXPECT_TRUE(
+      SoFSearch::Private::isRepetition(hashes.data(), historySize, hashes.size(), board));
+
+  // Repetition of the position that occurred only on the search path
+  Board fresh = Board::initialPosition();
+  std::vector<board_hash_t> path;
+  for (const char *str : {"g1f3", "g8f6", "f3g1", "f6g8"}) {
+    path.push_back(fresh.hash);
+    moveMake(fresh, SoFCore::moveParse(str, fresh));
+  }
+  EXPECT_TRUE(SoFSearch::Private::isRepetition(path.data(), 0, path.size(), fresh));
+}
@@ -0,0 +1,146 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "search/private/util.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "core/move.h"
+#include "eval/score.h"
+#include "search/private/consts.h"
+
+using SoFCore::Move;
+using SoFCore::MoveKind;
+using SoFSearch::Private::HistoryTable;
+
+namespace History = SoFSearch::Private::History;
+
+TEST(SoFSearch, HistoryTable_Update) {
+  HistoryTable history;
+  const Move move{MoveKind::Simple, 52, 36, 0};
+  const Move other{MoveKind::Simple, 51, 35, 0};
+  EXPECT_EQ(history[move], 0);
+  history.update(move, 100);
+  EXPECT_EQ(history[move], 100);
+  EXPECT_EQ(history[other], 0);
+  history.update(move, -100);
+  EXPECT_LT(history[move], 100);
+  EXPECT_GT(history[move], -100);
+}
+
+TEST(SoFSearch, HistoryTable_Gravity) {
+  HistoryTable history;
+  const Move move{MoveKind::Simple, 52, 36, 0};
+  for (int i = 0; i < 1000; ++i) {
+    history.update(move, History::MAX_BONUS);
+    ASSERT_LE(history[move], HistoryTable::MAX);
+  }
+  EXPECT_GE(history[move], HistoryTable::MAX - History::MAX_BONUS);
+  for (int i = 0; i < 1000; ++i) {
+    history.update(move, -History::MAX_BONUS);
+    ASSERT_GE(history[move], -HistoryTable::MAX);
+  }
+  EXPECT_LE(history[move], -HistoryTable::MAX + History::MAX_BONUS);
+
+  // The largest possible bonus moves the entry exactly to the bound
+  history.update(move, HistoryTable::MAX);
+  EXPECT_EQ(history[move], HistoryTable::MAX);
+  history.update(move, HistoryTable::MAX);
+  EXPECT_EQ(history[move], HistoryTable::MAX);
+  history.update(move, -HistoryTable::MAX);
+  EXPECT_EQ(history[move], -HistoryTable::MAX);
+}
+
+TEST(SoFSearch, HistoryTable_Bonus) {
+  EXPECT_EQ(HistoryTable::bonus(1), History::BONUS_MUL);
+  EXPECT_EQ(HistoryTable::bonus(3), 9 * History::BONUS_MUL);
+  EXPECT_EQ(HistoryTable::bonus(100), History::MAX_BONUS);
+  EXPECT_LE(History::MAX_BONUS, HistoryTable::MAX);
+
+  // A malus is capped in the same way as a bonus, so the entry never goes below the bound
+  HistoryTable history;
+  const Move move{MoveKind::Simple, 12, 28, 0};
+  for (int i = 0; i < 1000; ++i) {
+    history.update(move, -HistoryTable::bonus(100));
+    ASSERT_GE(history[move], -HistoryTable::MAX);
+  }
+}
+
+TEST(SoFSearch, HistoryTable_AgeAndClear) {
+  HistoryTable history;
+  const Move move{MoveKind::Simple, 52, 36, 0};
+  const Move other{MoveKind::Simple, 6, 21, 0};
+  history.update(move, 1000);
+  history.update(other, -1000);
+  history.age();
+  EXPECT_EQ(history[move], 500);
+  EXPECT_EQ(history[other], -500);
+  history.clear();
+  EXPECT_EQ(history[move], 0);
+  EXPECT_EQ(history[other], 0);
+}
+
+TEST(SoFSearch, RootMoveList_Reorder) {
+  using SoFSearch::Private::RootMoveList;
+
+  const Move moves[] = {
+      Move{MoveKind::Simple, 52, 36, 0}, Move{MoveKind::Simple, 51, 35, 0},
+      Move{MoveKind::Simple, 62, 45, 0}, Move{MoveKind::Simple, 57, 42, 0},
+      Move{MoveKind::Simple, 48, 40, 0},
+  };
+  const uint64_t nodes[] = {100, 500, 300, 500, 10};
+
+  RootMoveList list;
+  for (const Move move : moves) {
+    list.add(move);
+  }
+  ASSERT_EQ(list.size(), 5U);
+  for (size_t i = 0; i < 5; ++i) {
+    RootMoveList::Item *item = list.find(moves[i]);
+    ASSERT_NE(item, nullptr);
+    item->nodes = nodes[i];
+    item->score = static_cast<SoFEval::score_t>(i * 10);
+  }
+  EXPECT_EQ(list.find(Move{MoveKind::Simple, 0, 1, 0}), nullptr);
+
+  // The best move goes first even if it has the smallest number of nodes. The remaining moves are
+  // sorted by nodes in descending order, and the moves with equal node count keep their order
+  list.reorder(moves[4]);
+  ASSERT_EQ(list.size(), 5U);
+  EXPECT_EQ(list[0].move, moves[4]);
+  EXPECT_EQ(list[1].move, moves[1]);
+  EXPECT_EQ(list[2].move, moves[3]);
+  EXPECT_EQ(list[3].move, moves[2]);
+  EXPECT_EQ(list[4].move, moves[0]);
+
+  // The statistics are reset for the next iteration
+  for (const RootMoveList::Item &item : list) {
+    EXPECT_EQ(item.nodes, 0U);
+    EXPECT_EQ(item.score, -SoFEval::SCORE_INF);
+  }
+
+  // Without any statistics, only the best move changes its place
+  list.reorder(moves[0]);
+  EXPECT_EQ(list[0].move, moves[0]);
+  EXPECT_EQ(list[1].move, moves[4]);
+  EXPECT_EQ(list[2].move, moves[1]);
+  EXPECT_EQ(list[3].move, moves[3]);
+  EXPECT_EQ(list[4].move, moves[2]);
+}
@@ -0,0 +1,69 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "search/thread_budget.h"
+
+#include <algorithm>
+
+namespace SoFSearch {
+
+ThreadBudget::ThreadBudget(const size_t threads) : total_(std::max<size_t>(threads, 1)) {}
+
+void ThreadBudget::attach() {
+  std::lock_guard guard(lock_);
+  ++engines_;
+}
+
+void ThreadBudget::detach() {
+  std::lock_guard guard(lock_);
+  --engines_;
+}
+
+std::optional<ThreadBudget::Lease> ThreadBudget::acquire(
+    const size_t requested, const std::function<bool()> &cancelled) {
+  std::unique_lock guard(lock_);
+  released_.wait(guard, [&]() { return used_ < total_ || cancelled(); });
+  if (used_ >= total_) {
+    return std::nullopt;
+  }
+  const size_t free = total_ - used_;
+  const size_t fairShare = std::max<size_t>(total_ / std::max<size_t>(engines_, 1), 1);
+  const size_t threads = std::max<size_t>(std::min({requested, free, fairShare}), 1);
+  used_ += threads;
+  return Lease(this, threads);
+}
+
+void ThreadBudget::wakeWaiters() {
+  // Lock and unlock `lock_` to ensure that no thread is between checking the condition and starting
+  // to wait in `acquire()`, otherwise it may miss the notification
+  lock_.lock();
+  lock_.unlock();
+  released_.notify_all();
+}
+
+void ThreadBudget::Lease::release() {
+  if (!budget_) {
+    return;
+  }
+  std::unique_lock guard(budget_->lock_);
+  budget_->used_ -= threads_;
+  guard.unlock();
+  budget_->released_.notify_all();
+  budget_ = nullptr;
+}
+
+}  // namespace SoFSearch
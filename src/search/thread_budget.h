@@ -0,0 +1,107 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef SOF_SEARCH_THREAD_BUDGET_INCLUDED
+#define SOF_SEARCH_THREAD_BUDGET_INCLUDED
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+
+#include "util/no_copy_move.h"
+
+namespace SoFSearch {
+
+// Limits the total number of search threads used by multiple engines in the same process. The
+// engines attach to the budget when they are created. Each search takes a lease of threads from the
+// budget when it starts and returns it when it finishes. This class is thread-safe
+class ThreadBudget : public SoFUtil::NoCopyMove {
+public:
+  // Threads taken from the budget. They are returned to the budget on destruction
+  class Lease {
+  public:
+    // Creates a lease of `threads` threads which is not bound to any budget
+    explicit Lease(const size_t threads) : threads_(threads) {}
+
+    Lease(const Lease &) = delete;
+    Lease &operator=(const Lease &) = delete;
+
+    Lease(Lease &&other) noexcept : budget_(other.budget_), threads_(other.threads_) {
+      other.budget_ = nullptr;
+    }
+
+    Lease &operator=(Lease &&other) noexcept {
+      if (this != &other) {
+        release();
+        budget_ = other.budget_;
+        threads_ = other.threads_;
+        other.budget_ = nullptr;
+      }
+      return *this;
+    }
+
+    ~Lease() { release(); }
+
+    // Returns the number of threads which the search is allowed to use
+    inline size_t threads() const { return threads_; }
+
+  private:
+    friend class ThreadBudget;
+
+    Lease(ThreadBudget *budget, const size_t threads) : budget_(budget), threads_(threads) {}
+
+    void release();
+
+    ThreadBudget *budget_ = nullptr;
+    size_t threads_;
+  };
+
+  // Creates the budget of `threads` threads
+  explicit ThreadBudget(size_t threads);
+
+  // Registers or unregisters the engine which uses the budget
+  void attach();
+  void detach();
+
+  // Takes up to `requested` threads from the budget. The search gets no more than the number of
+  // free threads and no more than its fair share, i.e. the budget divided by the number of attached
+  // engines. If the budget is exhausted, blocks until some other lease returns its threads, so the
+  // searches are queued instead of oversubscribing the CPU. The wait is cancelled if `cancelled`
+  // returns `true`, in which case `std::nullopt` is returned. `cancelled` is checked each time the
+  // waiting thread wakes up, so the caller must call `wakeWaiters()` after the condition changes.
+  // The lease must not outlive the budget
+  std::optional<Lease> acquire(size_t requested, const std::function<bool()> &cancelled);
+
+  // Wakes up all the threads waiting in `acquire()`, so they recheck whether the wait is cancelled
+  void wakeWaiters();
+
+  // Returns the total number of threads in the budget
+  inline size_t threads() const { return total_; }
+
+private:
+  std::mutex lock_;
+  std::condition_variable released_;
+  size_t total_;
+  size_t used_ = 0;
+  size_t engines_ = 0;
+};
+
+}  // namespace SoFSearch
+
+#endif  // SOF_SEARCH_THREAD_BUDGET_INCLUDED
@@ -0,0 +1,83 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/mapped_file.h"
+
+#include "config.h"
+
+#ifdef USE_POSIX_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+namespace SoFUtil {
+
+#ifdef USE_POSIX_MMAP
+
+Result<std::unique_ptr<MappedFile>, IOError> MappedFile::open(const std::string &path) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return Err(IOError{"Unable to open file \"" + path + "\""});
+  }
+  struct stat st {};
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    close(fd);
+    return Err(IOError{"Unable to map file \"" + path + "\": file is empty or unreadable"});
+  }
+  const auto size = static_cast<size_t>(st.st_size);
+  void *data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  // The mapping remains valid after the descriptor is closed
+  close(fd);
+  if (data == MAP_FAILED) {
+    return Err(IOError{"Unable to map file \"" + path + "\""});
+  }
+  return Ok(std::unique_ptr<MappedFile>(
+      new MappedFile(static_cast<const unsigned char *>(data), size)));
+}
+
+MappedFile::~MappedFile() {
+  munmap(const_cast<unsigned char *>(data_), size_);  // NOLINT
+}
+
+#else
+
+Result<std::unique_ptr<MappedFile>, IOError> MappedFile::open(const std::string &path) {
+  std::ifstream in(path, std::ios_base::in | std::ios_base::binary);
+  if (!in.is_open()) {
+    return Err(IOError{"Unable to open file \"" + path + "\""});
+  }
+  std::vector<unsigned char> buffer((std::istreambuf_iterator<char>(in)),
+                                    std::istreambuf_iterator<char>());
+  if (buffer.empty()) {
+    return Err(IOError{"Unable to map file \"" + path + "\": file is empty or unreadable"});
+  }
+  std::unique_ptr<MappedFile> file(new MappedFile(nullptr, buffer.size()));
+  file->buffer_ = std::move(buffer);
+  file->data_ = file->buffer_.data();
+  return Ok(std::move(file));
+}
+
+MappedFile::~MappedFile() = default;
+
+#endif
+
+}  // namespace SoFUtil
@@ -0,0 +1,54 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef SOF_UTIL_MAPPED_FILE_INCLUDED
+#define SOF_UTIL_MAPPED_FILE_INCLUDED
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "util/ioutil.h"
+#include "util/no_copy_move.h"
+#include "util/result.h"
+
+namespace SoFUtil {
+
+// Read-only file mapped into memory. If the platform doesn't support memory mapping, the file is
+// read into memory instead
+class MappedFile : public NoCopyMove {
+public:
+  // Maps the file `path`. Empty files cannot be mapped
+  static Result<std::unique_ptr<MappedFile>, IOError> open(const std::string &path);
+
+  ~MappedFile();
+
+  inline const unsigned char *data() const { return data_; }
+  inline size_t size() const { return size_; }
+
+private:
+  MappedFile(const unsigned char *data, const size_t size) : data_(data), size_(size) {}
+
+  const unsigned char *data_;
+  size_t size_;
+  std::vector<unsigned char> buffer_;  // File contents, if the file is not mapped
+};
+
+}  // namespace SoFUtil
+
+#endif  // SOF_UTIL_MAPPED_FILE_INCLUDED
@@ -0,0 +1,118 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/shared_memory.h"
+
+#include "config.h"
+
+#ifdef USE_POSIX_SHM
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#endif
+
+namespace SoFUtil {
+
+#ifdef USE_POSIX_SHM
+
+// If the segment is just created by another process, it may not have its final size yet. Wait for
+// this time before giving up
+constexpr auto SEGMENT_SIZE_TIMEOUT = std::chrono::seconds(1);
+
+static IOError shmError(const std::string &name, const char *action) {
+  return IOError{std::string("Unable to ") + action + " shared memory \"" + name +
+                 "\": " + std::strerror(errno)};
+}
+
+Result<std::unique_ptr<SharedMemory>, IOError> SharedMemory::open(const std::string &name,
+                                                                  size_t size) {
+  // POSIX requires the name to start with slash
+  const std::string shmName = (!name.empty() && name[0] == '/') ? name : "/" + name;
+
+  bool created = true;
+  int fd = shm_open(shmName.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd < 0 && errno == EEXIST) {
+    created = false;
+    fd = shm_open(shmName.c_str(), O_RDWR, 0600);
+  }
+  if (fd < 0) {
+    return Err(shmError(name, "open"));
+  }
+
+  if (created) {
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+      const IOError error = shmError(name, "resize");
+      close(fd);
+      shm_unlink(shmName.c_str());
+      return Err(error);
+    }
+  } else {
+    // The creator may not have set the size yet
+    const auto deadline = std::chrono::steady_clock::now() + SEGMENT_SIZE_TIMEOUT;
+    struct stat st {};
+    while (true) {
+      if (fstat(fd, &st) != 0) {
+        const IOError error = shmError(name, "query");
+        close(fd);
+        return Err(error);
+      }
+      if (st.st_size != 0) {
+        break;
+      }
+      if (std::chrono::steady_clock::now() > deadline) {
+        close(fd);
+        return Err(IOError{"Shared memory \"" + name + "\" is empty"});
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    size = static_cast<size_t>(st.st_size);
+  }
+
+  void *data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  // The mapping remains valid after the descriptor is closed
+  close(fd);
+  if (data == MAP_FAILED) {
+    return Err(shmError(name, "map"));
+  }
+  return Ok(std::unique_ptr<SharedMemory>(new SharedMemory(shmName, data, size, created)));
+}
+
+void SharedMemory::unlink() { shm_unlink(name_.c_str()); }
+
+SharedMemory::~SharedMemory() { munmap(data_, size_); }
+
+#else
+
+Result<std::unique_ptr<SharedMemory>, IOError> SharedMemory::open(const std::string &name,
+                                                                  size_t) {
+  return Err(IOError{"Unable to open shared memory \"" + name +
+                     "\": shared memory is not supported on this platform"});
+}
+
+void SharedMemory::unlink() {}
+
+SharedMemory::~SharedMemory() = default;
+
+#endif
+
+}  // namespace SoFUtil
@@ -0,0 +1,69 @@
+// This file is part of SoFCheck
+//
+// Copyright (c) 2026 Alexander Kernozhitsky and SoFCheck contributors
+//
+// SoFCheck is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// SoFCheck is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with SoFCheck.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef SOF_UTIL_SHARED_MEMORY_INCLUDED
+#define SOF_UTIL_SHARED_MEMORY_INCLUDED
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "util/ioutil.h"
+#include "util/no_copy_move.h"
+#include "util/result.h"
+
+namespace SoFUtil {
+
+// Named shared memory segment mapped into the address space of the current process. All the
+// processes that open the segment with the same name see the same memory.
+//
+// The segment is not removed when the processes close it, so the next processes find it with the
+// same contents. It lives until `unlink()` is called, the system is rebooted or the segment is
+// removed manually (e.g. via `rm /dev/shm/<name>` on Linux). Currently, only POSIX shared memory is
+// supported
+class SharedMemory : public NoCopyMove {
+public:
+  // Opens the segment with name `name`. If the segment doesn't exist, it is created with `size`
+  // bytes filled with zeros, and `isCreated()` returns `true`. Otherwise, the existing segment is
+  // mapped, and its size may differ from `size`. Note that the contents of the created segment may
+  // be observed by other processes even before this function returns
+  static Result<std::unique_ptr<SharedMemory>, IOError> open(const std::string &name, size_t size);
+
+  ~SharedMemory();
+
+  inline void *data() const { return data_; }
+  inline size_t size() const { return size_; }
+  inline bool isCreated() const { return created_; }
+
+  // Removes the name of the segment, so the next call to `open()` creates a new segment. The memory
+  // remains mapped in all the processes which use it, and is freed when all of them close it
+  void unlink();
+
+private:
+  SharedMemory(std::string name, void *data, const size_t size, const bool created)
+      : name_(std::move(name)), data_(data), size_(size), created_(created) {}
+
+  std::string name_;
+  void *data_;
+  size_t size_;
+  bool created_;
+};
+
+}  // namespace SoFUtil
+
+#endif  // SOF_UTIL_SHARED_MEMORY_INCLUDED